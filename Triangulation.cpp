@@ -1,21 +1,43 @@
 #include "Triangulation.hpp"
 #include "model_io.hpp"
+#include "ply_io.hpp"
+#include "welding.hpp"
 
+#include <algorithm>
+#include <array>
 #include <fstream>
 #include <iostream>
-#include <sstream>
+#include <stdexcept>
 #include <unordered_map>
 
 namespace half_edge {
 
+namespace {
+
+std::size_t change_blocks(std::size_t size)
+{
+    return (size + Triangulation::CHANGE_BLOCK_SIZE - 1) >> Triangulation::CHANGE_BLOCK_SHIFT;
+}
+
+void mark_block(std::vector<bool>& blocks, index i)
+{
+    const auto block = i >> Triangulation::CHANGE_BLOCK_SHIFT;
+    if(block >= blocks.size())
+    {
+        blocks.resize(block + 1, false);
+    }
+    blocks[block] = true;
+}
+
+}
+
 // Read the mesh from a file in OFF format
-std::vector<index> Triangulation::read_OFFfile(const std::string& name)
+std::pmr::vector<index> Triangulation::read_OFFfile(const std::string& name, std::pmr::memory_resource* scratch)
 {
     // Read the OFF file
-    std::vector<index> faces;
-    std::string line;
+    std::pmr::vector<index> faces(scratch);
+    std::pmr::string line(scratch);
     std::ifstream off_file(name);
-    std::string tmp;
     if(!off_file.is_open())
     {
         std::cerr << "unable to open file " << name << std::endl;
@@ -25,67 +47,75 @@ std::vector<index> Triangulation::read_OFFfile(const std::string& name)
     // Check first line is a OFF file
     while(std::getline(off_file, line))
     {
-        // add check boundary vertices flag
-        std::istringstream(line) >> tmp;
-        if(tmp[0] != '#' && !contains_only_whitespaces(line))
+        if(is_line_to_skip(line))
         {
-            if(tmp.starts_with("OFF")) // Check if the format is OFF
-                break;
-            else
-            {
-                std::cout << "The file is not an OFF file" << std::endl;
-                exit(0);
-            }
+            continue;
         }
+        if(trim_leading_whitespace(line).starts_with(OFF_HEADER)) // Check if the format is OFF
+        {
+            break;
+        }
+        throw std::invalid_argument("The file is not an OFF file: " + name);
     }
     // Read the number of vertices and faces
     while(std::getline(off_file, line))
     {
-        // add check boundary vertices flag
-        std::istringstream(line) >> tmp;
-        if(tmp[0] != '#' && !contains_only_whitespaces(line))
+        if(is_line_to_skip(line))
         {
-            std::istringstream(line) >> this->n_vertices >> this->n_faces;
-            this->m_vertices.reserve(this->n_vertices);
-            faces.reserve(3 * this->n_faces);
-            break;
+            continue;
+        }
+        long long vertices_count{0};
+        long long faces_count{0};
+        std::string_view text = line;
+        if(!parse_next(text, vertices_count) || !parse_next(text, faces_count) || vertices_count < 0 ||
+           faces_count < 0)
+        {
+            throw std::invalid_argument("failed to parse the number of vertices and faces");
         }
+        this->n_vertices = static_cast<std::size_t>(vertices_count);
+        this->n_faces = static_cast<std::size_t>(faces_count);
+        this->m_vertices.reserve(this->n_vertices);
+        faces.reserve(3 * this->n_faces);
+        break;
     }
     // Read vertices
     index idx{0};
     while(idx < n_vertices && std::getline(off_file, line))
     {
-        std::istringstream(line) >> tmp;
-        if(tmp[0] != '#' && !contains_only_whitespaces(line))
+        if(is_line_to_skip(line))
+        {
+            continue;
+        }
+        double a1{0.};
+        double a2{0.};
+        std::string_view text = line;
+        if(!parse_next(text, a1) || !parse_next(text, a2))
         {
-            double a1;
-            double a2;
-            double a3;
-            std::istringstream(line) >> a1 >> a2 >> a3;
-            vertex ve;
-            ve.x = a1;
-            ve.y = a2;
-            this->m_vertices.push_back(ve);
-            idx++;
+            throw std::invalid_argument("failed to parse the vertices");
         }
+        this->m_vertices.emplace_back(a1, a2);
+        idx++;
     }
     // Read faces
     idx = 0;
     while(idx < n_faces && std::getline(off_file, line))
     {
-        std::istringstream(line) >> tmp;
-        if(is_line_to_skip(tmp))
+        if(is_line_to_skip(line))
         {
             continue;
         }
-        std::size_t length;
-        std::size_t t1;
-        std::size_t t2;
-        std::size_t t3;
-        std::istringstream(line) >> length >> t1 >> t2 >> t3;
-        faces.push_back(t1);
-        faces.push_back(t2);
-        faces.push_back(t3);
+        std::string_view text = line;
+        std::array<long long, 4> values{};
+        for(auto& value : values)
+        {
+            if(!parse_next(text, value) || value < 0)
+            {
+                throw std::invalid_argument("failed to parse the faces: " + std::string(line));
+            }
+        }
+        faces.push_back(static_cast<index>(values[1]));
+        faces.push_back(static_cast<index>(values[2]));
+        faces.push_back(static_cast<index>(values[3]));
         idx++;
     }
 
@@ -93,31 +123,98 @@ std::vector<index> Triangulation::read_OFFfile(const std::string& name)
     return faces;
 }
 
-Triangulation::Triangulation(const std::string& OFF_file)
+Triangulation::Triangulation(const std::string& mesh_file)
+    : Triangulation(mesh_file, welding_options{}, build_resources{})
+{}
+
+Triangulation::Triangulation(const std::string& mesh_file, const welding_options& welding)
+    : Triangulation(mesh_file, welding, build_resources{})
+{}
+
+Triangulation::Triangulation(const std::string& mesh_file,
+                             const welding_options& welding,
+                             const build_resources& resources)
+    : m_vertices(resources.storage != nullptr ? resources.storage : std::pmr::get_default_resource()),
+      m_half_edges(m_vertices.get_allocator()),
+      m_edge_index(m_vertices.get_allocator())
 {
-    std::cout << "Reading OFF file " << OFF_file << std::endl;
-    std::vector<index> faces = read_OFFfile(OFF_file);
-    construct_interior_halfEdges_from_faces(faces);
+    // the temporaries are released together when the arena goes out of scope
+    std::pmr::monotonic_buffer_resource arena(resources.scratch != nullptr ? resources.scratch
+                                                                           : std::pmr::get_default_resource());
+    std::pmr::vector<index> faces(&arena);
+    if(is_ply_file(mesh_file))
+    {
+        std::cout << "Reading PLY file " << mesh_file << std::endl;
+        read_PLYfile(mesh_file, m_vertices, faces);
+        n_vertices = m_vertices.size();
+        n_faces = faces.size() / 3;
+    }
+    else
+    {
+        std::cout << "Reading OFF file " << mesh_file << std::endl;
+        faces = read_OFFfile(mesh_file, &arena);
+    }
+    if(welding.enabled)
+    {
+        auto options = welding;
+        options.scratch = options.scratch != nullptr ? options.scratch : &arena;
+        weld_vertices(m_vertices, faces, options);
+        n_vertices = m_vertices.size();
+        n_faces = faces.size() / 3;
+    }
+    construct_interior_halfEdges_from_faces(faces, &arena);
+    construct_exterior_halfEdges();
+}
+
+Triangulation::Triangulation(std::vector<vertex> vertices, const std::vector<index>& faces)
+    : Triangulation(std::span<const vertex>(vertices), faces, build_resources{})
+{}
+
+Triangulation::Triangulation(std::span<const vertex> vertices,
+                             std::span<const index> faces,
+                             const build_resources& resources)
+    : n_faces(faces.size() / 3),
+      n_vertices(vertices.size()),
+      m_vertices(vertices.begin(),
+                 vertices.end(),
+                 resources.storage != nullptr ? resources.storage : std::pmr::get_default_resource()),
+      m_half_edges(m_vertices.get_allocator()),
+      m_edge_index(m_vertices.get_allocator())
+{
+    if(faces.size() % 3 != 0)
+    {
+        throw std::invalid_argument("the number of face indices must be a multiple of 3");
+    }
+    std::pmr::monotonic_buffer_resource arena(resources.scratch != nullptr ? resources.scratch
+                                                                           : std::pmr::get_default_resource());
+    construct_interior_halfEdges_from_faces(faces, &arena);
     construct_exterior_halfEdges();
 }
 
 // Generate interior halfedges using a vector with the faces of the triangulation
 // if an interior half-edge is border, it is mark as border-edge
 // mark border-edges
-void Triangulation::construct_interior_halfEdges_from_faces(const std::vector<index>& faces)
+void Triangulation::construct_interior_halfEdges_from_faces(std::span<const index> faces,
+                                                            std::pmr::memory_resource* scratch)
 {
-    auto hash_for_pair = [](const _edge& p) { return std::hash<index>{}(p.first) ^ std::hash<index>{}(p.second); };
-
-    // set of edges to calculate the boundary and twin edges
-    std::unordered_map<_edge, index, decltype(hash_for_pair)> map_edges(3 * this->n_faces, hash_for_pair);
+    if(faces.size() < 3 * this->n_faces)
+    {
+        throw std::invalid_argument("fewer face indices than faces");
+    }
+    m_adjacency.reset();
+    // set of edges to calculate the boundary and twin edges, a temporary of the scratch resource
+    std::pmr::unordered_map<_edge, index, edge_hash> map_edges(scratch);
+    map_edges.reserve(3 * this->n_faces);
+    release_edge_index();
+    m_half_edges.reserve(m_half_edges.size() + 3 * this->n_faces);
 
     for(std::size_t i = 0; i < n_faces; i++)
     {
         for(std::size_t j = 0; j < 3; j++)
         {
             half_edge he{};
-            const auto v_origin = faces.at(3 * i + j);
-            const auto v_target = faces.at(3 * i + (j + 1) % 3);
+            const auto v_origin = faces[3 * i + j];
+            const auto v_target = faces[3 * i + (j + 1) % 3];
             he.origin = v_origin;
             he.next = i * 3 + (j + 1) % 3;
             he.prev = i * 3 + (j + 2) % 3;
@@ -155,12 +252,14 @@ void Triangulation::construct_interior_halfEdges_from_faces(const std::vector<in
             m_vertices.at(tgt).is_border = true;
         }
     }
+    all_changed();
 }
 
 // Generate exterior half edges
 // This takes  n + k time where n is the number of vertices and k is the number of border edges
 void Triangulation::construct_exterior_halfEdges()
 {
+    m_adjacency.reset();
     // search interior edges labed as border, generates exterior edges
     // with the origin and target inverted and add at the of HalfEdges vector
     // std::cout<<"Size vector: "<<HalfEdges.size()<<std::endl;
@@ -213,6 +312,7 @@ void Triangulation::construct_exterior_halfEdges()
         }
     }
     this->n_half_edges = m_half_edges.size();
+    all_changed();
 }
 
 // Given an edge with vertex origin v, return the next counterclockwise edge of v with v as origin
@@ -233,7 +333,909 @@ index Triangulation::CW_edge_to_vertex(index e) const
     return m_half_edges.at(twn).next;
 }
 
+// Return the halfedge from v0 to v1, looked up in the edge index when it is kept and found by rotating around v0
+// otherwise
+index Triangulation::find_halfedge(index v0, index v1) const
+{
+    if(m_has_edge_index)
+    {
+        const auto it = m_edge_index.find({v0, v1});
+        return it == m_edge_index.end() ? INVALID_INDEX : it->second;
+    }
+    const auto start = m_vertices.at(v0).incident_halfedge;
+    if(start == INVALID_INDEX)
+    {
+        return INVALID_INDEX;
+    }
+    auto e = start;
+    do
+    {
+        if(target(e) == v1)
+        {
+            return e;
+        }
+        e = CCW_edge_to_vertex(e);
+    } while(e != start);
+    return INVALID_INDEX;
+}
+
+void Triangulation::reserve(std::size_t vertices, std::size_t faces)
+{
+    m_vertices.reserve(vertices);
+    // each face brings at most one exterior halfedge per edge
+    m_half_edges.reserve(6 * faces + 2);
+}
+
+index Triangulation::allocate_vertex()
+{
+    ++this->n_vertices;
+    if(!m_free_vertices.empty())
+    {
+        const auto v = m_free_vertices.back();
+        m_free_vertices.pop_back();
+        vertex_ref(v) = vertex{};
+        return v;
+    }
+    m_vertices.emplace_back();
+    vertex_changed(m_vertices.size() - 1);
+    return m_vertices.size() - 1;
+}
+
+index Triangulation::allocate_half_edge()
+{
+    ++this->n_half_edges;
+    if(!m_free_half_edges.empty())
+    {
+        const auto e = m_free_half_edges.back();
+        m_free_half_edges.pop_back();
+        half_edge_ref(e) = half_edge{};
+        return e;
+    }
+    m_half_edges.emplace_back();
+    halfEdge_changed(m_half_edges.size() - 1);
+    return m_half_edges.size() - 1;
+}
+
+index Triangulation::allocate_face()
+{
+    ++this->n_faces;
+    this->n_half_edges += 3;
+    if(!m_free_faces.empty())
+    {
+        const auto f = m_free_faces.back();
+        m_free_faces.pop_back();
+        for(std::size_t k = 0; k < 3; ++k)
+        {
+            half_edge_ref(3 * f + k) = half_edge{};
+        }
+        return f;
+    }
+    // the halfedges of a face start on a multiple of 3, the padding slots are left for exterior halfedges
+    const auto first = m_half_edges.size();
+    while(m_half_edges.size() % 3 != 0)
+    {
+        m_free_half_edges.push_back(m_half_edges.size());
+        m_half_edges.emplace_back().is_removed = true;
+    }
+    m_half_edges.resize(m_half_edges.size() + 3);
+    for(auto e = first; e < m_half_edges.size(); ++e)
+    {
+        halfEdge_changed(e);
+    }
+    return m_half_edges.size() / 3 - 1;
+}
+
+void Triangulation::release_vertex(index v)
+{
+    vertex_ref(v) = vertex{};
+    vertex_ref(v).is_removed = true;
+    m_free_vertices.push_back(v);
+    --this->n_vertices;
+}
+
+void Triangulation::release_half_edge(index e)
+{
+    half_edge_ref(e) = half_edge{};
+    half_edge_ref(e).is_removed = true;
+    m_free_half_edges.push_back(e);
+    --this->n_half_edges;
+}
+
+void Triangulation::release_face(index f)
+{
+    for(std::size_t k = 0; k < 3; ++k)
+    {
+        half_edge_ref(3 * f + k) = half_edge{};
+        half_edge_ref(3 * f + k).is_removed = true;
+    }
+    m_free_faces.push_back(f);
+    --this->n_faces;
+    this->n_half_edges -= 3;
+}
+
+void Triangulation::vertex_changed(index v)
+{
+    if(m_track_changes)
+    {
+        mark_block(m_changed_vertex_blocks, v);
+    }
+}
+
+void Triangulation::halfEdge_changed(index e)
+{
+    if(m_track_changes)
+    {
+        mark_block(m_changed_half_edge_blocks, e);
+    }
+}
+
+vertex& Triangulation::vertex_ref(index v)
+{
+    auto& vert = m_vertices.at(v);
+    vertex_changed(v);
+    return vert;
+}
+
+half_edge& Triangulation::half_edge_ref(index e)
+{
+    auto& he = m_half_edges.at(e);
+    halfEdge_changed(e);
+    return he;
+}
+
+void Triangulation::all_changed()
+{
+    if(m_track_changes)
+    {
+        m_changed_vertex_blocks.assign(change_blocks(m_vertices.size()), true);
+        m_changed_half_edge_blocks.assign(change_blocks(m_half_edges.size()), true);
+    }
+}
+
+void Triangulation::track_changes(bool enabled)
+{
+    m_track_changes = enabled;
+    clear_changes();
+}
+
+void Triangulation::clear_changes()
+{
+    m_changed_vertex_blocks.clear();
+    m_changed_half_edge_blocks.clear();
+}
+
+bool Triangulation::is_vertex_block_changed(std::size_t block) const
+{
+    return block < m_changed_vertex_blocks.size() && m_changed_vertex_blocks[block];
+}
+
+bool Triangulation::is_halfEdge_block_changed(std::size_t block) const
+{
+    return block < m_changed_half_edge_blocks.size() && m_changed_half_edge_blocks[block];
+}
+
+void Triangulation::set_next(index e, index n)
+{
+    half_edge_ref(e).next = n;
+    half_edge_ref(n).prev = e;
+}
+
+void Triangulation::update_vertex(index v, index fallback)
+{
+    auto& vert = vertex_ref(v);
+    if(vert.incident_halfedge == INVALID_INDEX)
+    {
+        vert.incident_halfedge = fallback;
+    }
+    vert.is_border = false;
+    const auto start = vert.incident_halfedge;
+    auto e = start;
+    do
+    {
+        if(m_half_edges.at(e).is_border)
+        {
+            vert.is_border = true;
+            break;
+        }
+        e = CCW_edge_to_vertex(e);
+    } while(e != start);
+}
+
+index Triangulation::add_vertex(double x, double y)
+{
+    m_adjacency.reset();
+    const auto v = allocate_vertex();
+    vertex_ref(v).x = x;
+    vertex_ref(v).y = y;
+    return v;
+}
+
+void Triangulation::set_point(index v, double x, double y)
+{
+    vertex_ref(v).x = x;
+    vertex_ref(v).y = y;
+}
+
+// Add a face following the boundary re-linking of OpenMesh: existing halfedges must be exterior ones, they are
+// moved into the slots of the new face once the boundary loops are re-linked
+index Triangulation::add_face(index v0, index v1, index v2)
+{
+    m_adjacency.reset();
+    const std::array<index, 3> v{v0, v1, v2};
+    if(v0 == v1 || v1 == v2 || v2 == v0)
+    {
+        throw std::invalid_argument("a face needs three distinct vertices");
+    }
+    std::array<index, 3> inner{};
+    std::array<bool, 3> is_new{};
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+        if(!is_vertex_alive(v[i]))
+        {
+            throw std::invalid_argument("face vertex does not exist");
+        }
+        const auto& vert = m_vertices[v[i]];
+        if(vert.incident_halfedge != INVALID_INDEX && !vert.is_border)
+        {
+            throw std::invalid_argument("face vertex is not on the boundary, the face would be non-manifold");
+        }
+        inner[i] = find_halfedge(v[i], v[(i + 1) % 3]);
+        is_new[i] = inner[i] == INVALID_INDEX;
+        if(!is_new[i] && !m_half_edges.at(inner[i]).is_border)
+        {
+            throw std::invalid_argument("face edge is already shared by two faces");
+        }
+    }
+
+    // plan the re-links of the boundary loops so that two consecutive existing halfedges follow each other, on an
+    // overlay of the links: nothing is changed before the whole face is known to fit
+    std::array<std::pair<index, index>, 9> relinks{};
+    std::size_t n_relinks{0};
+    const auto planned_next = [&](index e)
+    {
+        for(auto k = n_relinks; k > 0; --k)
+        {
+            if(relinks.at(k - 1).first == e)
+            {
+                return relinks.at(k - 1).second;
+            }
+        }
+        return next(e);
+    };
+    const auto planned_prev = [&](index e)
+    {
+        for(auto k = n_relinks; k > 0; --k)
+        {
+            if(relinks.at(k - 1).second == e)
+            {
+                return relinks.at(k - 1).first;
+            }
+        }
+        return prev(e);
+    };
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+        const auto ii = (i + 1) % 3;
+        if(is_new[i] || is_new[ii] || planned_next(inner[i]) == inner[ii])
+        {
+            continue;
+        }
+        const auto inner_prev = inner[i];
+        const auto inner_next = inner[ii];
+        const auto outer_prev = twin(inner_next);
+        auto boundary_prev = outer_prev;
+        do
+        {
+            boundary_prev = twin(planned_next(boundary_prev));
+            if(boundary_prev == outer_prev)
+            {
+                throw std::invalid_argument("no free gap to re-link the boundary around the face");
+            }
+        } while(!m_half_edges.at(boundary_prev).is_border || boundary_prev == inner_prev);
+        const auto boundary_next = planned_next(boundary_prev);
+        if(boundary_next == inner_next)
+        {
+            throw std::invalid_argument("no free gap to re-link the boundary around the face");
+        }
+        const auto patch_start = planned_next(inner_prev);
+        const auto patch_end = planned_prev(inner_next);
+        relinks.at(n_relinks++) = {boundary_prev, patch_start};
+        relinks.at(n_relinks++) = {patch_end, boundary_next};
+        relinks.at(n_relinks++) = {inner_prev, inner_next};
+    }
 
+    // a vertex between two new edges takes the face in a gap of its boundary, the re-links above do not touch it
+    std::array<index, 3> gaps{};
+    gaps.fill(INVALID_INDEX);
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+        const auto ii = (i + 1) % 3;
+        const auto start = m_vertices[v[ii]].incident_halfedge;
+        if(!is_new[i] || !is_new[ii] || start == INVALID_INDEX)
+        {
+            continue;
+        }
+        auto boundary_next = start;
+        while(!m_half_edges.at(boundary_next).is_border)
+        {
+            boundary_next = twin(planned_prev(boundary_next));
+            if(boundary_next == start)
+            {
+                throw std::invalid_argument("face vertex is not on the boundary");
+            }
+        }
+        gaps.at(ii) = boundary_next;
+    }
 
+    // from here on the face is added
+    for(std::size_t i = 0; i < n_relinks; ++i)
+    {
+        set_next(relinks.at(i).first, relinks.at(i).second);
+    }
 
-}
\ No newline at end of file
+    const auto f = allocate_face();
+    const auto t = 3 * f;
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+        if(!is_new[i])
+        {
+            continue;
+        }
+        inner[i] = t + i;
+        const auto outer = allocate_half_edge();
+        auto& he = half_edge_ref(t + i);
+        he.origin = v[i];
+        he.twin = outer;
+        auto& he_out = half_edge_ref(outer);
+        he_out.origin = v[(i + 1) % 3];
+        he_out.twin = t + i;
+        he_out.is_border = true;
+    }
+
+    // links to set once all of them are known, the boundary queries below need the previous ones
+    std::array<std::pair<index, index>, 9> next_cache{};
+    std::size_t n_cache{0};
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+        const auto ii = (i + 1) % 3;
+        const auto inner_prev = inner[i];
+        const auto inner_next = inner[ii];
+        const auto outer_prev = twin(inner_next);
+        const auto outer_next = twin(inner_prev);
+        if(is_new[i] && !is_new[ii])
+        {
+            next_cache.at(n_cache++) = {prev(inner_next), outer_next};
+        }
+        else if(!is_new[i] && is_new[ii])
+        {
+            next_cache.at(n_cache++) = {outer_prev, next(inner_prev)};
+        }
+        else if(is_new[i] && is_new[ii])
+        {
+            if(gaps.at(ii) == INVALID_INDEX)
+            {
+                next_cache.at(n_cache++) = {outer_prev, outer_next};
+            }
+            else
+            {
+                // insert the face in the gap of the boundary around vh
+                const auto boundary_next = gaps.at(ii);
+                next_cache.at(n_cache++) = {prev(boundary_next), outer_next};
+                next_cache.at(n_cache++) = {outer_prev, boundary_next};
+            }
+        }
+        next_cache.at(n_cache++) = {inner_prev, inner_next};
+    }
+    for(std::size_t i = 0; i < n_cache; ++i)
+    {
+        set_next(next_cache.at(i).first, next_cache.at(i).second);
+    }
+
+    // move the former exterior halfedges into the face slots
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+        if(!is_new[i])
+        {
+            const auto old = inner[i];
+            const auto twn = twin(old);
+            half_edge_ref(t + i).origin = v[i];
+            half_edge_ref(t + i).twin = twn;
+            half_edge_ref(twn).twin = t + i;
+            if(m_vertices.at(v[i]).incident_halfedge == old)
+            {
+                vertex_ref(v[i]).incident_halfedge = t + i;
+            }
+            release_half_edge(old);
+        }
+        auto& he = half_edge_ref(t + i);
+        he.next = t + (i + 1) % 3;
+        he.prev = t + (i + 2) % 3;
+        he.is_border = false;
+    }
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+        update_vertex(v[i], t + i);
+    }
+    if(m_has_edge_index)
+    {
+        for(std::size_t i = 0; i < 3; ++i)
+        {
+            m_edge_index[{v[i], v[(i + 1) % 3]}] = t + i;
+            m_edge_index[{v[(i + 1) % 3], v[i]}] = twin(t + i);
+        }
+    }
+    return f;
+}
+
+void Triangulation::build_edge_index()
+{
+    m_edge_index.clear();
+    m_edge_index.reserve(n_half_edges);
+    for(index e = 0; e < m_half_edges.size(); ++e)
+    {
+        if(!m_half_edges[e].is_removed)
+        {
+            m_edge_index[{origin(e), target(e)}] = e;
+        }
+    }
+    m_has_edge_index = true;
+}
+
+void Triangulation::release_edge_index()
+{
+    decltype(m_edge_index)(m_edge_index.get_allocator()).swap(m_edge_index);
+    m_has_edge_index = false;
+}
+
+std::vector<index> Triangulation::apply_delta(const std::vector<index>& removed_faces,
+                                              const std::vector<index>& added_faces)
+{
+    // check what can be checked before changing anything, the added faces are checked by add_face
+    if(added_faces.size() % 3 != 0)
+    {
+        throw std::invalid_argument("the number of face indices must be a multiple of 3");
+    }
+    auto removed = removed_faces;
+    std::ranges::sort(removed);
+    if(std::ranges::adjacent_find(removed) != removed.end())
+    {
+        throw std::invalid_argument("a face is removed twice");
+    }
+    if(!std::ranges::all_of(removed, [this](index f) { return is_face_alive(f); }))
+    {
+        throw std::invalid_argument("face does not exist");
+    }
+    if(!std::ranges::all_of(added_faces, [this](index v) { return is_vertex_alive(v); }))
+    {
+        throw std::invalid_argument("face vertex does not exist");
+    }
+    if(!m_has_edge_index)
+    {
+        build_edge_index();
+    }
+
+    // the vertices of the removed faces may be used by the added ones, they are released at the end if isolated
+    std::vector<index> touched;
+    touched.reserve(3 * removed_faces.size());
+    std::vector<index> faces;
+    faces.reserve(added_faces.size() / 3);
+    try
+    {
+        for(const auto f : removed_faces)
+        {
+            const std::array<index, 3> v{origin(3 * f), origin(3 * f + 1), origin(3 * f + 2)};
+            remove_face(f, false);
+            touched.insert(touched.end(), v.begin(), v.end());
+        }
+        for(std::size_t i = 0; i < added_faces.size(); i += 3)
+        {
+            faces.push_back(add_face(added_faces[i], added_faces[i + 1], added_faces[i + 2]));
+        }
+    }
+    catch(const std::invalid_argument&)
+    {
+        // an added face breaks the manifold: undo in reverse order, the free lists give the same face indices back
+        for(auto f = faces.rbegin(); f != faces.rend(); ++f)
+        {
+            remove_face(*f, false);
+        }
+        for(auto t = touched.size(); t > 0; t -= 3)
+        {
+            add_face(touched[t - 3], touched[t - 2], touched[t - 1]);
+        }
+        throw;
+    }
+    for(const auto v : touched)
+    {
+        if(is_vertex_alive(v) && m_vertices[v].incident_halfedge == INVALID_INDEX)
+        {
+            release_vertex(v);
+        }
+    }
+    return faces;
+}
+
+// Remove a face following OpenMesh: its halfedges become exterior ones, the edges left without any face are
+// removed and the boundary loops re-linked around them
+void Triangulation::delete_face(index f) { remove_face(f, true); }
+
+void Triangulation::remove_face(index f, bool release_isolated)
+{
+    m_adjacency.reset();
+    if(!is_face_alive(f))
+    {
+        throw std::invalid_argument("face does not exist");
+    }
+    const auto t = 3 * f;
+    std::array<index, 3> v{};
+    std::array<index, 3> h{};
+    std::array<bool, 3> remove_edge{};
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+        v[i] = origin(t + i);
+        remove_edge[i] = m_half_edges.at(twin(t + i)).is_border;
+    }
+    // the kept halfedges leave the face slots and become exterior
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+        h[i] = t + i;
+        if(remove_edge[i])
+        {
+            continue;
+        }
+        h[i] = allocate_half_edge();
+        half_edge_ref(h[i]) = m_half_edges.at(t + i);
+        half_edge_ref(h[i]).is_border = true;
+        half_edge_ref(twin(h[i])).twin = h[i];
+        if(m_vertices.at(v[i]).incident_halfedge == t + i)
+        {
+            vertex_ref(v[i]).incident_halfedge = h[i];
+        }
+    }
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+        set_next(h[i], h[(i + 1) % 3]);
+    }
+
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+        if(!remove_edge[i])
+        {
+            continue;
+        }
+        const auto h0 = h[i];
+        const auto h1 = twin(h0);
+        const auto next0 = next(h0);
+        const auto prev0 = prev(h0);
+        const auto next1 = next(h1);
+        const auto prev1 = prev(h1);
+        set_next(prev0, next1);
+        set_next(prev1, next0);
+        // v0 is the origin of h1, v1 the origin of h0
+        auto& v0 = vertex_ref(v[(i + 1) % 3]);
+        auto& v1 = vertex_ref(v[i]);
+        if(v0.incident_halfedge == h1)
+        {
+            v0.incident_halfedge = next0 == h1 ? INVALID_INDEX : next0;
+        }
+        if(v1.incident_halfedge == h0)
+        {
+            v1.incident_halfedge = next1 == h0 ? INVALID_INDEX : next1;
+        }
+    }
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+        if(remove_edge[i])
+        {
+            release_half_edge(twin(t + i));
+        }
+    }
+    release_face(f);
+    if(m_has_edge_index)
+    {
+        for(std::size_t i = 0; i < 3; ++i)
+        {
+            const _edge e{v[i], v[(i + 1) % 3]};
+            if(remove_edge[i])
+            {
+                m_edge_index.erase(e);
+                m_edge_index.erase({e.second, e.first});
+            }
+            else
+            {
+                m_edge_index[e] = h[i];
+            }
+        }
+    }
+    for(const auto vi : v)
+    {
+        if(m_vertices.at(vi).incident_halfedge == INVALID_INDEX)
+        {
+            if(release_isolated)
+            {
+                release_vertex(vi);
+            }
+        }
+        else
+        {
+            vertex_ref(vi).is_border = true;
+        }
+    }
+}
+
+index Triangulation::split_face_side(index x, index m)
+{
+    const auto g = allocate_face();
+    const auto g0 = 3 * g;
+    const auto g1 = g0 + 1;
+    const auto g2 = g0 + 2;
+    const auto xn = next(x);
+    const auto xp = prev(x);
+    const auto q = origin(xn);
+    const auto r = origin(xp);
+    const auto xn_twin = twin(xn);
+
+    // g1 takes over the edge q -> r of x's face
+    auto& he1 = half_edge_ref(g1);
+    he1.origin = q;
+    he1.twin = xn_twin;
+    he1.next = g2;
+    he1.prev = g0;
+    half_edge_ref(xn_twin).twin = g1;
+    if(m_vertices.at(q).incident_halfedge == xn)
+    {
+        vertex_ref(q).incident_halfedge = g1;
+    }
+    auto& he0 = half_edge_ref(g0);
+    he0.origin = m;
+    he0.next = g1;
+    he0.prev = g2;
+    auto& he2 = half_edge_ref(g2);
+    he2.origin = r;
+    he2.twin = xn;
+    he2.next = g0;
+    he2.prev = g1;
+    // xn becomes the inner edge m -> r
+    half_edge_ref(xn).origin = m;
+    half_edge_ref(xn).twin = g2;
+    return g0;
+}
+
+index Triangulation::split_edge(index e, double x, double y)
+{
+    if(!is_halfEdge_alive(e))
+    {
+        throw std::invalid_argument("edge does not exist");
+    }
+    m_adjacency.reset();
+    release_edge_index();
+    if(m_half_edges.at(e).is_border)
+    {
+        e = twin(e);
+    }
+    const auto t = twin(e);
+    const auto m = add_vertex(x, y);
+
+    const auto e2 = split_face_side(e, m);
+    index t2{};
+    if(m_half_edges.at(t).is_border)
+    {
+        t2 = allocate_half_edge();
+        half_edge_ref(t2).origin = m;
+        half_edge_ref(t2).is_border = true;
+        set_next(t2, next(t));
+        set_next(t, t2);
+        vertex_ref(m).is_border = true;
+    }
+    else
+    {
+        t2 = split_face_side(t, m);
+    }
+    half_edge_ref(e).twin = t2;
+    half_edge_ref(t2).twin = e;
+    half_edge_ref(e2).twin = t;
+    half_edge_ref(t).twin = e2;
+    vertex_ref(m).incident_halfedge = e2;
+    return m;
+}
+
+index Triangulation::split_edge(index e)
+{
+    const auto a = origin(e);
+    const auto b = target(e);
+    return split_edge(e, 0.5 * (get_PointX(a) + get_PointX(b)), 0.5 * (get_PointY(a) + get_PointY(b)));
+}
+
+bool Triangulation::is_collapse_ok(index e) const
+{
+    if(!is_halfEdge_alive(e))
+    {
+        return false;
+    }
+    const auto t = twin(e);
+    const auto a = origin(e);
+    const auto b = origin(t);
+    const auto& he = m_half_edges.at(e);
+    const auto& he_twin = m_half_edges.at(t);
+
+    // a triangle with its two other edges on the boundary would leave a dangling edge
+    index c = INVALID_INDEX;
+    if(!he.is_border)
+    {
+        c = origin(he.prev);
+        if(m_half_edges.at(twin(he.next)).is_border && m_half_edges.at(twin(he.prev)).is_border)
+        {
+            return false;
+        }
+    }
+    index d = INVALID_INDEX;
+    if(!he_twin.is_border)
+    {
+        d = origin(he_twin.prev);
+        if(m_half_edges.at(twin(he_twin.next)).is_border && m_half_edges.at(twin(he_twin.prev)).is_border)
+        {
+            return false;
+        }
+    }
+    if(c == d)
+    {
+        return false;
+    }
+    // an interior edge between two boundary vertices would pinch the surface
+    if(!he.is_border && !he_twin.is_border && m_vertices.at(a).is_border && m_vertices.at(b).is_border)
+    {
+        return false;
+    }
+    // link condition: the only common neighbours of a and b are the opposite vertices c and d
+    auto ea = e;
+    do
+    {
+        const auto w = target(ea);
+        if(w != b && w != c && w != d && find_halfedge(b, w) != INVALID_INDEX)
+        {
+            return false;
+        }
+        ea = CCW_edge_to_vertex(ea);
+    } while(ea != e);
+    return true;
+}
+
+void Triangulation::collapse_face_side(index x)
+{
+    // x: p -> q in the face (p, q, r), the origins have already been merged
+    const auto xn = next(x);
+    const auto xp = prev(x);
+    const auto p_r = twin(xp);
+    const auto r_q = twin(xn);
+    half_edge_ref(p_r).twin = r_q;
+    half_edge_ref(r_q).twin = p_r;
+    const std::array<index, 3> face{x, xn, xp};
+    for(const auto hf : face)
+    {
+        auto& incident = vertex_ref(origin(hf)).incident_halfedge;
+        if(incident == x || incident == xn || incident == xp)
+        {
+            incident = hf == xp ? r_q : p_r;
+        }
+    }
+    release_face(x / 3);
+}
+
+index Triangulation::collapse_edge(index e)
+{
+    if(!is_collapse_ok(e))
+    {
+        throw std::invalid_argument("collapsing the edge would make the triangulation non-manifold");
+    }
+    // the collapse is certain from here, a rejected one keeps the index and the adjacency
+    m_adjacency.reset();
+    release_edge_index();
+    const auto t = twin(e);
+    const auto a = origin(e);
+    const auto b = origin(t);
+
+    // the outgoing halfedges of a now start from b
+    auto ea = e;
+    do
+    {
+        half_edge_ref(ea).origin = b;
+        ea = CCW_edge_to_vertex(ea);
+    } while(ea != e);
+
+    const std::array<index, 2> sides{e, t};
+    for(const auto side : sides)
+    {
+        if(!m_half_edges.at(side).is_border)
+        {
+            collapse_face_side(side);
+            continue;
+        }
+        const auto nxt = next(side);
+        set_next(prev(side), nxt);
+        if(m_vertices.at(b).incident_halfedge == side)
+        {
+            vertex_ref(b).incident_halfedge = nxt;
+        }
+        release_half_edge(side);
+    }
+    vertex_ref(b).is_border = m_vertices.at(b).is_border || m_vertices.at(a).is_border;
+    release_vertex(a);
+    return b;
+}
+
+compaction_map Triangulation::compact()
+{
+    m_adjacency.reset();
+    release_edge_index();
+    compaction_map map;
+    map.vertices.assign(m_vertices.size(), INVALID_INDEX);
+    map.half_edges.assign(m_half_edges.size(), INVALID_INDEX);
+    map.faces.assign(face_slots(), INVALID_INDEX);
+
+    index n_v{0};
+    for(index v = 0; v < m_vertices.size(); ++v)
+    {
+        if(!m_vertices[v].is_removed)
+        {
+            map.vertices[v] = n_v++;
+        }
+    }
+    index n_f{0};
+    for(index f = 0; f < map.faces.size(); ++f)
+    {
+        if(is_face_alive(f))
+        {
+            map.faces[f] = n_f;
+            for(std::size_t k = 0; k < 3; ++k)
+            {
+                map.half_edges[3 * f + k] = 3 * n_f + k;
+            }
+            ++n_f;
+        }
+    }
+    index n_e{3 * n_f};
+    for(index e = 0; e < m_half_edges.size(); ++e)
+    {
+        if(!m_half_edges[e].is_removed && m_half_edges[e].is_border)
+        {
+            map.half_edges[e] = n_e++;
+        }
+    }
+
+    const auto remap_edge = [&map](index e) { return e == INVALID_INDEX ? e : map.half_edges.at(e); };
+    std::pmr::vector<vertex> vertices(n_v, m_vertices.get_allocator());
+    for(index v = 0; v < m_vertices.size(); ++v)
+    {
+        if(map.vertices[v] != INVALID_INDEX)
+        {
+            auto& vert = vertices[map.vertices[v]];
+            vert = m_vertices[v];
+            vert.incident_halfedge = remap_edge(vert.incident_halfedge);
+        }
+    }
+    std::pmr::vector<half_edge> half_edges(n_e, m_half_edges.get_allocator());
+    for(index e = 0; e < m_half_edges.size(); ++e)
+    {
+        if(map.half_edges[e] != INVALID_INDEX)
+        {
+            auto& he = half_edges[map.half_edges[e]];
+            he = m_half_edges[e];
+            he.origin = map.vertices.at(he.origin);
+            he.twin = remap_edge(he.twin);
+            he.next = map.half_edges.at(he.next);
+            he.prev = map.half_edges.at(he.prev);
+        }
+    }
+    m_vertices = std::move(vertices);
+    m_half_edges = std::move(half_edges);
+    m_free_vertices.clear();
+    m_free_faces.clear();
+    m_free_half_edges.clear();
+    this->n_vertices = n_v;
+    this->n_faces = n_f;
+    this->n_half_edges = n_e;
+    all_changed();
+    return map;
+}
+
+}
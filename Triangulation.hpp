@@ -1,8 +1,13 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -11,7 +16,8 @@ using index = std::size_t;
 using _edge = std::pair<index, index>;
 
 constexpr auto NOT_A_TWIN = std::numeric_limits<std::size_t>::max();
-
+/// marks a missing vertex, half-edge or face, e.g. the incident halfedge of an isolated vertex
+constexpr auto INVALID_INDEX = std::numeric_limits<std::size_t>::max();
 
 
 struct vertex
@@ -21,7 +27,9 @@ struct vertex
     /// whether the vertex is on the boundary
     bool is_border{false};
     /// halfedge incident to the vertex, vertex is the origin of the halfedge
-    index incident_halfedge{};
+    index incident_halfedge{INVALID_INDEX};
+    /// whether the slot has been released and waits in the free list
+    bool is_removed{false};
 
     vertex() = default;
 
@@ -41,6 +49,8 @@ struct half_edge
     index prev{};
     /// whether the halfedge is on the boundary
     bool is_border{false};
+    /// whether the slot has been released and waits in the free list
+    bool is_removed{false};
 
     // Default constructor
     half_edge() = default;
@@ -60,6 +70,42 @@ struct half_edge
 
 };
 
+/// Hash of a directed edge mixing both vertices, so that the regular numberings of grids do not collide
+struct edge_hash
+{
+    std::size_t operator()(const _edge& e) const noexcept
+    {
+        auto h = static_cast<std::uint64_t>(e.first) * 0x9E3779B97F4A7C15ULL ^ static_cast<std::uint64_t>(e.second);
+        h ^= h >> 32U;
+        h *= 0xD6E8FEB86659FD93ULL;
+        h ^= h >> 32U;
+        return static_cast<std::size_t>(h);
+    }
+};
+
+struct adjacency_options;
+struct vertex_adjacency;
+struct welding_options;
+
+/// Memory resources of the construction of a Triangulation, the caller keeps them alive as long as they are used
+struct build_resources
+{
+    /// upstream of the monotonic arena holding the temporaries of the loading and of the construction, the arena is
+    /// released in one shot when the constructor returns; nullptr for the default resource
+    std::pmr::memory_resource* scratch{nullptr};
+    /// resource of the vertex and halfedge arrays and of the edge index, for the whole life of the triangulation and
+    /// of the triangulations moved from it; nullptr for the default resource
+    std::pmr::memory_resource* storage{nullptr};
+};
+
+/// Old to new index maps produced by Triangulation::compact(), removed elements map to INVALID_INDEX
+struct compaction_map
+{
+    std::vector<index> vertices{};
+    std::vector<index> half_edges{};
+    std::vector<index> faces{};
+};
+
 class Triangulation
 {
   private:
@@ -75,16 +121,80 @@ class Triangulation
     double t_triangulation_generation{0};
 
     /// AoS of vertices
-    std::vector<vertex> m_vertices{};
+    std::pmr::vector<vertex> m_vertices{};
     /// AoS of half-edges
-    std::vector<half_edge> m_half_edges{};
+    std::pmr::vector<half_edge> m_half_edges{};
+
+    /// released vertex slots
+    std::vector<index> m_free_vertices{};
+    /// released faces, the three half-edges 3f, 3f+1, 3f+2 of a free face f are all unused
+    std::vector<index> m_free_faces{};
+    /// released single half-edge slots, only reused for exterior half-edges
+    std::vector<index> m_free_half_edges{};
+
+    /// vertex adjacency built on demand, dropped whenever the connectivity changes
+    std::shared_ptr<const vertex_adjacency> m_adjacency{};
+
+    /// halfedge of each directed edge (origin, target), interior and exterior ones, built on demand by
+    /// build_edge_index() or apply_delta() and maintained by add_face and delete_face; the other edits drop it
+    std::pmr::unordered_map<_edge, index, edge_hash> m_edge_index{};
+    bool m_has_edge_index{false};
+
+    /// blocks of CHANGE_BLOCK_SIZE slots written since the last clear_changes(), recorded while m_track_changes is set
+    std::vector<bool> m_changed_vertex_blocks{};
+    std::vector<bool> m_changed_half_edge_blocks{};
+    bool m_track_changes{false};
+
+    index allocate_vertex();
+    index allocate_face();
+    index allocate_half_edge();
+    void release_vertex(index v);
+    void release_face(index f);
+    void release_half_edge(index e);
+
+    // every write to an element after the construction goes through these, to record the changed blocks
+    vertex& vertex_ref(index v);
+    half_edge& half_edge_ref(index e);
+    void vertex_changed(index v);
+    void halfEdge_changed(index e);
+    void all_changed();
+
+    // link e -> n in a face or a boundary loop
+    void set_next(index e, index n);
+    // refresh the border flag of v, and set its incident halfedge to fallback if it has none
+    void update_vertex(index v, index fallback);
+    // split the interior halfedge x in two at the new vertex m, x keeps the first half
+    // Output: the halfedge from m to the former target of x, its twin is left to the caller
+    index split_face_side(index x, index m);
+    // remove the face of the interior halfedge x whose origin has been merged into its target
+    void collapse_face_side(index x);
+    // remove the face f, its vertices left isolated are released if release_isolated is true
+    void remove_face(index f, bool release_isolated);
 
   public:
-    explicit Triangulation(const std::string& OFF_file);
+    // Read the OFF or PLY file and weld its duplicated vertices with the default welding options
+    explicit Triangulation(const std::string& mesh_file);
+
+    // Read the OFF or PLY file and weld its duplicated vertices, unless disabled, before the construction
+    Triangulation(const std::string& mesh_file, const welding_options& welding);
+
+    // Read the OFF or PLY file, the temporaries live in an arena released at the end of the construction and the
+    // arrays in the storage resource
+    Triangulation(const std::string& mesh_file, const welding_options& welding, const build_resources& resources);
 
-    std::vector<index> read_OFFfile(const std::string& name);
+    // Build the triangulation from vertices and a flatten vector of triangle vertex indices
+    Triangulation(std::vector<vertex> vertices, const std::vector<index>& faces);
 
-    void construct_interior_halfEdges_from_faces(const std::vector<index>& faces);
+    // Build the triangulation from vertices and triangle vertex indices, the arrays live in the storage resource
+    Triangulation(std::span<const vertex> vertices, std::span<const index> faces, const build_resources& resources);
+
+    // Read the OFF file, the faces and the line buffer are allocated from the scratch resource
+    std::pmr::vector<index> read_OFFfile(const std::string& name,
+                                         std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+    // the map of the edges used to find the twins is allocated from the scratch resource
+    void construct_interior_halfEdges_from_faces(std::span<const index> faces,
+                                                 std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
 
     void construct_exterior_halfEdges();
 
@@ -92,6 +202,26 @@ class Triangulation
     [[nodiscard]] auto halfEdges_size() const { return n_half_edges; };
     [[nodiscard]] auto vertices_size() const { return n_vertices; };
 
+    // Number of slots, i.e. one past the largest index, including the released ones waiting in the free lists
+    [[nodiscard]] auto face_slots() const { return m_half_edges.size() / 3; }
+    [[nodiscard]] auto halfEdge_slots() const { return m_half_edges.size(); }
+    [[nodiscard]] auto vertex_slots() const { return m_vertices.size(); }
+
+    // Raw storage indexed by slot, including the released slots, e.g. to copy the triangulation to shared memory
+    [[nodiscard]] std::span<const vertex> vertex_storage() const { return m_vertices; }
+    [[nodiscard]] std::span<const half_edge> halfEdge_storage() const { return m_half_edges; }
+
+    [[nodiscard]] bool is_vertex_alive(index v) const { return v < m_vertices.size() && !m_vertices[v].is_removed; }
+    [[nodiscard]] bool is_halfEdge_alive(index e) const
+    {
+        return e < m_half_edges.size() && !m_half_edges[e].is_removed;
+    }
+    // a face f is made of the interior halfedges 3f, 3f+1 and 3f+2
+    [[nodiscard]] bool is_face_alive(index f) const
+    {
+        return 3 * f < m_half_edges.size() && !m_half_edges[3 * f].is_removed && !m_half_edges[3 * f].is_border;
+    }
+
     // Calculates the tail vertex of the edge e
     // Input: e is the edge
     // Output: the tail vertex v of the edge e
@@ -129,9 +259,11 @@ class Triangulation
     // Input: edge e
     // Output: true if is the face of e is border face
     //         false otherwise
-    [[nodiscard]] bool is_border_face(index e) { return m_half_edges.at(e).is_border; }
+    [[nodiscard]] bool is_border_face(index e) const { return m_half_edges.at(e).is_border; }
 
-    bool is_border_vertex(index v);
+    // Input: vertex v
+    // Output: true if v is on the boundary, false otherwise
+    [[nodiscard]] bool is_border_vertex(index v) const { return m_vertices.at(v).is_border; }
 
     int degree(index v);
 
@@ -141,6 +273,82 @@ class Triangulation
     [[nodiscard]] auto get_PointX(index v) const { return m_vertices.at(v).x; }
     // return the y coordinate of the vertex v
     [[nodiscard]] auto get_PointY(index v) const { return m_vertices.at(v).y; }
+
+    // Return the halfedge going from v0 to v1
+    // Input: v0 and v1 are the vertices
+    // Output: the halfedge from v0 to v1, INVALID_INDEX if the vertices are not adjacent
+    [[nodiscard]] index find_halfedge(index v0, index v1) const;
+
+    // Grow the storage so that the given number of vertices and faces fits without reallocation
+    void reserve(std::size_t vertices, std::size_t faces);
+
+    // Add an isolated vertex, reusing a released slot if any
+    // Output: the index of the new vertex
+    index add_vertex(double x, double y);
+
+    void set_point(index v, double x, double y);
+
+    // Add the counterclockwise triangle (v0, v1, v2), the vertices must be isolated or on the boundary
+    // Output: the index of the new face
+    index add_face(index v0, index v1, index v2);
+
+    // Remove the face f, its vertices left isolated are removed as well
+    void delete_face(index f);
+
+    // Split the edge e at (x, y), the faces on both sides are split in two
+    // Output: the index of the new vertex
+    index split_edge(index e, double x, double y);
+
+    // Split the edge e at its midpoint
+    index split_edge(index e);
+
+    // Input: edge e
+    // Output: true if collapsing e keeps the triangulation manifold (link condition), false otherwise
+    [[nodiscard]] bool is_collapse_ok(index e) const;
+
+    // Collapse the edge e, its origin is merged into its target and the faces on both sides are removed
+    // Output: the surviving vertex, i.e. the target of e
+    index collapse_edge(index e);
+
+    // Move the live elements to the front, faces keep their relative order and the exterior halfedges follow the
+    // interior ones as after construction. Empties the free lists.
+    // Output: the old to new index maps
+    compaction_map compact();
+
+    // Remove then add faces, updating only the halfedges, boundary loops and vertices around them. The edges glued
+    // to the existing faces are found through the edge index kept from the construction, rebuilt first if an edit
+    // other than add_face and delete_face dropped it.
+    // Input: the faces to remove, and the counterclockwise triangles to add as a flatten vector of vertex indices,
+    //        added in order, each of them must keep the triangulation manifold. The vertices isolated once the
+    //        delta is applied are removed. When an added face is rejected, the delta is rolled back before the
+    //        exception is rethrown and the faces keep their indices.
+    // Output: the indices of the added faces
+    std::vector<index> apply_delta(const std::vector<index>& removed_faces, const std::vector<index>& added_faces);
+
+    // Record the blocks of CHANGE_BLOCK_SIZE vertex or halfedge slots written by the edits, so that a copy of the
+    // storage can be refreshed block by block. Enabling or disabling the tracking clears the record.
+    static constexpr std::size_t CHANGE_BLOCK_SHIFT = 10;
+    static constexpr std::size_t CHANGE_BLOCK_SIZE = std::size_t{1} << CHANGE_BLOCK_SHIFT;
+    void track_changes(bool enabled);
+    [[nodiscard]] bool is_tracking_changes() const { return m_track_changes; }
+    void clear_changes();
+    // Output: true if a slot of the block was written, or appended, since the last clear
+    [[nodiscard]] bool is_vertex_block_changed(std::size_t block) const;
+    [[nodiscard]] bool is_halfEdge_block_changed(std::size_t block) const;
+
+    // Build the edge index from the live halfedges, find_halfedge then looks the edges up instead of rotating around
+    // the vertices; it lives in the storage resource until released or dropped by an edit
+    void build_edge_index();
+
+    // Free the memory of the edge index, find_halfedge and add_face fall back to rotations around the vertices
+    void release_edge_index();
+
+    [[nodiscard]] bool has_edge_index() const { return m_has_edge_index; }
+
+    // Return the CSR vertex adjacency, built on first use and cached until the next change of connectivity
+    // Input: the layout of the adjacency, a cached adjacency with another layout is rebuilt
+    // Output: the adjacency, valid until the next edit (defined in adjacency.cpp)
+    const vertex_adjacency& adjacency(const adjacency_options& options);
 };
 
 
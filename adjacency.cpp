@@ -0,0 +1,115 @@
+#include "adjacency.hpp"
+#include "connectivity.hpp"
+#include "parallel.hpp"
+#include "versioned.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <utility>
+
+namespace half_edge {
+
+template<triangulation_like M>
+vertex_adjacency build_vertex_adjacency(const M& tri, const adjacency_options& options)
+{
+    const auto n = tri.vertex_slots();
+    const std::size_t diagonal = options.include_diagonal ? 1 : 0;
+    vertex_adjacency adjacency;
+    adjacency.options = options;
+    adjacency.offsets.assign(n + 1, 0);
+
+    // counting pass: the degree of each vertex is stored one slot ahead for the prefix sum
+    parallel_for(n,
+                 options.threads,
+                 [&tri, &adjacency, diagonal](std::size_t begin, std::size_t end)
+                 {
+                     for(auto v = begin; v < end; ++v)
+                     {
+                         if(!tri.is_vertex_alive(v))
+                         {
+                             continue;
+                         }
+                         std::size_t degree{diagonal};
+                         if(const auto start = tri.edge_of_vertex(v); start != INVALID_INDEX)
+                         {
+                             auto e = start;
+                             do
+                             {
+                                 ++degree;
+                                 e = tri.CCW_edge_to_vertex(e);
+                             } while(e != start);
+                         }
+                         adjacency.offsets[v + 1] = degree;
+                     }
+                 });
+    std::inclusive_scan(adjacency.offsets.begin(), adjacency.offsets.end(), adjacency.offsets.begin());
+
+    adjacency.neighbours.resize(adjacency.offsets.back());
+    if(options.edge_ids)
+    {
+        adjacency.edges.resize(adjacency.offsets.back());
+    }
+
+    // fill pass: every vertex writes its own row
+    parallel_for(n,
+                 options.threads,
+                 [&tri, &adjacency, &options](std::size_t begin, std::size_t end)
+                 {
+                     std::vector<std::pair<index, index>> row;
+                     for(auto v = begin; v < end; ++v)
+                     {
+                         if(adjacency.degree(v) == 0)
+                         {
+                             continue;
+                         }
+                         row.clear();
+                         if(options.include_diagonal)
+                         {
+                             row.emplace_back(v, INVALID_INDEX);
+                         }
+                         if(const auto start = tri.edge_of_vertex(v); start != INVALID_INDEX)
+                         {
+                             auto e = start;
+                             do
+                             {
+                                 row.emplace_back(tri.target(e), e);
+                                 e = tri.CCW_edge_to_vertex(e);
+                             } while(e != start);
+                         }
+                         if(options.sorted)
+                         {
+                             std::ranges::sort(row);
+                         }
+                         auto k = adjacency.offsets[v];
+                         for(const auto& [neighbour, edge] : row)
+                         {
+                             adjacency.neighbours[k] = neighbour;
+                             if(options.edge_ids)
+                             {
+                                 adjacency.edges[k] = edge;
+                             }
+                             ++k;
+                         }
+                     }
+                 });
+    return adjacency;
+}
+
+template vertex_adjacency build_vertex_adjacency(const Triangulation&, const adjacency_options&);
+template vertex_adjacency build_vertex_adjacency(const triangulation_view&, const adjacency_options&);
+template vertex_adjacency build_vertex_adjacency(const versioned_triangulation::snapshot&, const adjacency_options&);
+template vertex_adjacency build_vertex_adjacency(const half_edge_mesh&, const adjacency_options&);
+template vertex_adjacency build_vertex_adjacency(const corner_table_mesh&, const adjacency_options&);
+
+// cached here rather than in Triangulation.cpp to keep the CSR layout out of the core
+const vertex_adjacency& Triangulation::adjacency(const adjacency_options& options)
+{
+    if(!m_adjacency || !m_adjacency->options.same_layout(options))
+    {
+        m_adjacency = std::make_shared<const vertex_adjacency>(build_vertex_adjacency(*this, options));
+    }
+    return *m_adjacency;
+}
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Triangulation.hpp"
+#include "triangulation_view.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace half_edge {
+
+struct adjacency_options
+{
+    /// sort each row by increasing neighbour index instead of counterclockwise order
+    bool sorted{false};
+    /// store the halfedge from the vertex to each neighbour
+    bool edge_ids{false};
+    /// add the vertex itself to its row, first unless sorted, i.e. the sparsity pattern of the Laplacian matrix
+    bool include_diagonal{false};
+    /// number of worker threads, 0 for the hardware concurrency
+    std::size_t threads{0};
+
+    // whether both options produce the same adjacency, whatever the number of threads
+    [[nodiscard]] bool same_layout(const adjacency_options& other) const
+    {
+        return sorted == other.sorted && edge_ids == other.edge_ids && include_diagonal == other.include_diagonal;
+    }
+};
+
+/// Vertex to vertex adjacency in compressed sparse row (CSR) form, one row per vertex slot
+struct vertex_adjacency
+{
+    /// the neighbours of v are neighbours[offsets[v]] up to neighbours[offsets[v + 1]], removed vertices have none
+    std::vector<index> offsets{};
+    std::vector<index> neighbours{};
+    /// halfedge from the vertex to the neighbour of the same entry, INVALID_INDEX on the diagonal,
+    /// empty unless requested
+    std::vector<index> edges{};
+    /// options the adjacency was built with
+    adjacency_options options{};
+
+    [[nodiscard]] std::size_t degree(index v) const { return offsets[v + 1] - offsets[v]; }
+};
+
+/**
+ * Builds the vertex adjacency straight from the halfedges, with a parallel counting pass, a prefix sum of the
+ * row sizes and a parallel fill pass. Without sorting, the neighbours are in counterclockwise order.
+ *
+ * @param[in] tri The triangulation, instantiated for Triangulation, triangulation_view, the versioned snapshots and
+ *            the basic_triangulation meshes
+ * @param[in] options The layout of the rows and the number of threads
+ * @return the adjacency of all the vertex slots of the triangulation
+ */
+template<triangulation_like M>
+[[nodiscard]] vertex_adjacency build_vertex_adjacency(const M& tri, const adjacency_options& options = {});
+
+}
@@ -0,0 +1,186 @@
+#include "batch_loader.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <system_error>
+#include <utility>
+
+namespace half_edge {
+
+namespace {
+
+/// estimated bytes of a built triangulation per byte of OFF text
+constexpr std::size_t BYTES_PER_FILE_BYTE = 8;
+
+struct batch_state
+{
+    explicit batch_state(thread_pool& p, std::size_t budget) : pool(p), max_in_flight(budget) {}
+
+    thread_pool& pool;
+    std::size_t max_in_flight;
+    std::mutex mutex{};
+    std::deque<std::shared_ptr<load_job>> waiting{};
+    std::size_t in_flight{0};
+};
+
+}
+
+struct load_job
+{
+    std::shared_ptr<batch_state> state;
+    std::string path;
+    std::size_t cost{0};
+    std::promise<Triangulation> promise{};
+    /// the share is given back once the job is both finished and consumed, the flags are guarded by the state mutex
+    bool admitted{false};
+    bool finished{false};
+    bool consumed{false};
+};
+
+namespace {
+
+void admit(const std::shared_ptr<batch_state>& state);
+
+// take the share of the job and submit it, with the state locked
+void start(std::shared_ptr<load_job> job)
+{
+    const auto& state = job->state;
+    state->in_flight += job->cost;
+    job->admitted = true;
+    state->pool.submit(
+        [job]
+        {
+            try
+            {
+                job->promise.set_value(Triangulation(job->path));
+            }
+            catch(...)
+            {
+                job->promise.set_exception(std::current_exception());
+            }
+            const std::scoped_lock lock(job->state->mutex);
+            job->finished = true;
+            if(job->consumed)
+            {
+                job->state->in_flight -= job->cost;
+                admit(job->state);
+            }
+        });
+}
+
+// submit the waiting jobs that fit in the budget, with the state locked
+void admit(const std::shared_ptr<batch_state>& state)
+{
+    while(!state->waiting.empty())
+    {
+        const auto& job = state->waiting.front();
+        if(state->in_flight > 0 && state->in_flight + job->cost > state->max_in_flight)
+        {
+            return;
+        }
+        start(job);
+        state->waiting.pop_front();
+    }
+}
+
+}
+
+mesh_future::mesh_future(std::future<Triangulation> future, std::shared_ptr<load_job> job)
+    : m_future(std::move(future)), m_job(std::move(job))
+{
+}
+
+mesh_future& mesh_future::operator=(mesh_future&& other) noexcept
+{
+    if(this != &other)
+    {
+        release();
+        m_future = std::move(other.m_future);
+        m_job = std::move(other.m_job);
+    }
+    return *this;
+}
+
+mesh_future::~mesh_future() { release(); }
+
+void mesh_future::demand() const
+{
+    if(!m_job)
+    {
+        return;
+    }
+    const auto& state = m_job->state;
+    const std::scoped_lock lock(state->mutex);
+    if(!m_job->admitted)
+    {
+        std::erase(state->waiting, m_job);
+        start(m_job);
+    }
+}
+
+Triangulation mesh_future::get()
+{
+    demand();
+    try
+    {
+        auto mesh = m_future.get();
+        release();
+        return mesh;
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+void mesh_future::release() noexcept
+{
+    if(!m_job)
+    {
+        return;
+    }
+    const auto job = std::exchange(m_job, nullptr);
+    const auto& state = job->state;
+    const std::scoped_lock lock(state->mutex);
+    job->consumed = true;
+    if(!job->admitted)
+    {
+        std::erase(state->waiting, job);
+        return;
+    }
+    if(job->finished)
+    {
+        state->in_flight -= job->cost;
+        admit(state);
+    }
+}
+
+std::vector<mesh_future> load_meshes(thread_pool& pool,
+                                     const std::vector<std::string>& paths,
+                                     const batch_options& options)
+{
+    auto state = std::make_shared<batch_state>(pool, options.max_in_flight_bytes);
+    std::vector<mesh_future> futures;
+    futures.reserve(paths.size());
+    const std::scoped_lock lock(state->mutex);
+    for(const auto& path : paths)
+    {
+        auto job = std::make_shared<load_job>();
+        job->state = state;
+        job->path = path;
+        // a missing file costs nothing, its load fails right away
+        std::error_code error;
+        const auto size = std::filesystem::file_size(path, error);
+        job->cost = error ? 0 : static_cast<std::size_t>(size) * BYTES_PER_FILE_BYTE;
+        futures.emplace_back(job->promise.get_future(), job);
+        state->waiting.push_back(std::move(job));
+    }
+    admit(state);
+    return futures;
+}
+
+}
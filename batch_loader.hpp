@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Triangulation.hpp"
+#include "thread_pool.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace half_edge {
+
+struct batch_options
+{
+    /// bound on the estimated memory of the meshes read, built or waiting to be consumed at the same time, in bytes;
+    /// a file whose estimate exceeds the budget is loaded alone
+    std::size_t max_in_flight_bytes{std::size_t{1} << 30U};
+};
+
+/// a file of a batch with its share of the in-flight budget, defined by the loader
+struct load_job;
+
+/**
+ * Future of a mesh loaded by load_meshes. The mesh keeps its share of the in-flight budget until it is taken by
+ * get() or the future is destroyed, so that the meshes built but not consumed yet are bounded too. Waiting for a
+ * file not started yet starts it at once, over the budget if need be, so the futures can be consumed in any order.
+ */
+class mesh_future
+{
+  public:
+    mesh_future() = default;
+    mesh_future(std::future<Triangulation> future, std::shared_ptr<load_job> job);
+    mesh_future(const mesh_future&) = delete;
+    mesh_future& operator=(const mesh_future&) = delete;
+    mesh_future(mesh_future&& other) noexcept = default;
+    mesh_future& operator=(mesh_future&& other) noexcept;
+    // gives the share back, a file not started yet is dropped
+    ~mesh_future();
+
+    /**
+     * Waits for the load and takes the mesh, the share of the budget is given back whether the load failed or not.
+     * @return the mesh, the error of the file is rethrown
+     */
+    Triangulation get();
+
+    [[nodiscard]] bool valid() const { return m_future.valid(); }
+    void wait() const
+    {
+        demand();
+        m_future.wait();
+    }
+    template<class Rep, class Period>
+    [[nodiscard]] std::future_status wait_for(const std::chrono::duration<Rep, Period>& timeout) const
+    {
+        demand();
+        return m_future.wait_for(timeout);
+    }
+
+  private:
+    // start the file now if the budget has not admitted it yet
+    void demand() const;
+    void release() noexcept;
+
+    std::future<Triangulation> m_future{};
+    std::shared_ptr<load_job> m_job{};
+};
+
+/**
+ * Reads and builds OFF or PLY files on a thread pool, the degree of parallelism is the size of the pool. The files are
+ * started in order as long as the in-flight budget allows, each mesh consumed admits the next ones; a file waited for
+ * before its turn is started on demand.
+ * @param[in] pool The pool running the loads, it must outlive them
+ * @param[in] paths The OFF or PLY files
+ * @param[in] options The in-flight memory budget
+ * @return one future per path, get() rethrows the error of that file without affecting the others
+ */
+[[nodiscard]] std::vector<mesh_future> load_meshes(thread_pool& pool,
+                                                   const std::vector<std::string>& paths,
+                                                   const batch_options& options = {});
+
+}
@@ -0,0 +1,87 @@
+// Compares the memory and the traversal throughput of the halfedge and corner-table connectivity backends
+// Usage: connectivity_benchmark [vertices per side of the grid] [repetitions]
+
+#include "connectivity.hpp"
+#include "test_meshes.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// rotates around every vertex, returns the sum of the degrees
+template<class Mesh>
+std::size_t rotate_all(const Mesh& mesh)
+{
+    std::size_t steps = 0;
+    for(half_edge::index v = 0; v < mesh.vertices_size(); ++v)
+    {
+        const auto start = mesh.edge_of_vertex(v);
+        auto e = start;
+        do
+        {
+            ++steps;
+            e = mesh.CCW_edge_to_vertex(e);
+        } while(e != start);
+    }
+    return steps;
+}
+
+// walks next and twin over every halfedge, returns a checksum of the targets
+template<class Mesh>
+std::size_t walk_all(const Mesh& mesh)
+{
+    std::size_t checksum = 0;
+    for(half_edge::index e = 0; e < mesh.halfEdges_size(); ++e)
+    {
+        checksum += mesh.origin(mesh.twin(mesh.next(e))) + mesh.prev(e);
+    }
+    return checksum;
+}
+
+template<class Mesh>
+void run(const std::string& name, const Mesh& mesh, std::size_t repetitions)
+{
+    using clock = std::chrono::steady_clock;
+    std::size_t steps = 0;
+    auto start = clock::now();
+    for(std::size_t r = 0; r < repetitions; ++r)
+    {
+        steps += rotate_all(mesh);
+    }
+    const std::chrono::duration<double> rotation = clock::now() - start;
+
+    std::size_t checksum = 0;
+    start = clock::now();
+    for(std::size_t r = 0; r < repetitions; ++r)
+    {
+        checksum += walk_all(mesh);
+    }
+    const std::chrono::duration<double> walk = clock::now() - start;
+
+    const auto walked = static_cast<double>(repetitions * mesh.halfEdges_size());
+    std::cout << std::left << std::setw(14) << name << std::right << std::setw(12) << mesh.memory_bytes() / 1024
+              << " KiB" << std::setw(12) << std::fixed << std::setprecision(1)
+              << static_cast<double>(steps) / rotation.count() * 1e-6 << " M rotations/s" << std::setw(12)
+              << walked / walk.count() * 1e-6 << " M halfedges/s"
+              << "  (checksum " << checksum % 1000 << ")" << std::endl;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    const std::size_t repetitions = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10;
+    const auto tri = half_edge::test::make_grid(n);
+    const auto dense = half_edge::make_dense_connectivity(tri);
+    std::cout << tri.faces_size() << " faces, " << tri.halfEdges_size() << " halfedges" << std::endl;
+    run("half-edge", half_edge::half_edge_mesh(dense), repetitions);
+    run("corner table", half_edge::corner_table_mesh(dense), repetitions);
+    return EXIT_SUCCESS;
+}
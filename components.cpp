@@ -0,0 +1,297 @@
+#include "components.hpp"
+#include "connectivity.hpp"
+#include "parallel.hpp"
+#include "versioned.hpp"
+
+#include <atomic>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace half_edge {
+
+namespace {
+
+/// lock-free disjoint sets, the root of a set is its smallest element
+class concurrent_union_find
+{
+  public:
+    explicit concurrent_union_find(std::size_t n) : m_parent(n)
+    {
+        for(index i = 0; i < n; ++i)
+        {
+            m_parent[i].store(i, std::memory_order_relaxed);
+        }
+    }
+
+    index find(index x)
+    {
+        while(true)
+        {
+            auto p = m_parent[x].load(std::memory_order_acquire);
+            if(p == x)
+            {
+                return x;
+            }
+            // path halving, losing the race only skips the shortcut
+            const auto gp = m_parent[p].load(std::memory_order_acquire);
+            if(p != gp)
+            {
+                m_parent[x].compare_exchange_weak(p, gp, std::memory_order_acq_rel);
+            }
+            x = gp;
+        }
+    }
+
+    void unite(index a, index b)
+    {
+        while(true)
+        {
+            a = find(a);
+            b = find(b);
+            if(a == b)
+            {
+                return;
+            }
+            if(a < b)
+            {
+                std::swap(a, b);
+            }
+            // hang the larger root under the smaller one, retry if a got a parent in the meantime
+            auto expected = a;
+            if(m_parent[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel))
+            {
+                return;
+            }
+        }
+    }
+
+  private:
+    std::vector<std::atomic<index>> m_parent;
+};
+
+}
+
+template<triangulation_like M>
+face_components label_face_components(const M& tri, std::size_t threads)
+{
+    const auto n_faces = tri.face_slots();
+    concurrent_union_find sets(n_faces);
+    parallel_for(tri.halfEdge_slots(),
+                 threads,
+                 [&tri, &sets](std::size_t begin, std::size_t end)
+                 {
+                     for(auto e = begin; e < end; ++e)
+                     {
+                         if(!tri.is_halfEdge_alive(e) || tri.is_border_face(e))
+                         {
+                             continue;
+                         }
+                         const auto t = tri.twin(e);
+                         if(e < t && !tri.is_border_face(t))
+                         {
+                             sets.unite(e / 3, t / 3);
+                         }
+                     }
+                 });
+
+    face_components components;
+    components.labels.assign(n_faces, INVALID_INDEX);
+    // the roots are numbered in increasing order in a map of their own, the parallel pass below only reads it
+    std::vector<index> root_labels(n_faces, INVALID_INDEX);
+    for(index f = 0; f < n_faces; ++f)
+    {
+        if(tri.is_face_alive(f) && sets.find(f) == f)
+        {
+            root_labels[f] = components.count++;
+        }
+    }
+    parallel_for(n_faces,
+                 threads,
+                 [&tri, &sets, &root_labels, &components](std::size_t begin, std::size_t end)
+                 {
+                     for(auto f = begin; f < end; ++f)
+                     {
+                         if(tri.is_face_alive(f))
+                         {
+                             components.labels[f] = root_labels[sets.find(f)];
+                         }
+                     }
+                 });
+    return components;
+}
+
+template<triangulation_like M>
+dual_bfs_result dual_bfs(const M& tri, const std::vector<index>& sources, std::size_t threads)
+{
+    const auto n_faces = tri.face_slots();
+    std::vector<std::atomic<index>> distances(n_faces);
+    for(auto& d : distances)
+    {
+        d.store(INVALID_INDEX, std::memory_order_relaxed);
+    }
+
+    dual_bfs_result result;
+    result.layer_offsets.push_back(0);
+    for(const auto f : sources)
+    {
+        if(!tri.is_face_alive(f))
+        {
+            throw std::invalid_argument("source face does not exist");
+        }
+        if(distances[f].exchange(0, std::memory_order_relaxed) == INVALID_INDEX)
+        {
+            result.faces.push_back(f);
+        }
+    }
+
+    std::vector<std::vector<index>> next_frontiers;
+    for(index level = 0; result.faces.size() > result.layer_offsets.back(); ++level)
+    {
+        const auto frontier_begin = result.layer_offsets.back();
+        const auto frontier_size = result.faces.size() - frontier_begin;
+        result.layer_offsets.push_back(result.faces.size());
+
+        // every thread claims the unvisited neighbours of its part of the frontier
+        const auto n_threads = resolve_threads(threads, frontier_size);
+        const auto chunk = (frontier_size + n_threads - 1) / n_threads;
+        next_frontiers.assign(n_threads, {});
+        parallel_for(n_threads,
+                     n_threads,
+                     [&](std::size_t t_begin, std::size_t t_end)
+                     {
+                         for(auto t = t_begin; t < t_end; ++t)
+                         {
+                             const auto begin = frontier_begin + std::min(frontier_size, t * chunk);
+                             const auto end = frontier_begin + std::min(frontier_size, (t + 1) * chunk);
+                             for(auto k = begin; k < end; ++k)
+                             {
+                                 const auto f = result.faces[k];
+                                 for(std::size_t j = 0; j < 3; ++j)
+                                 {
+                                     const auto twn = tri.twin(3 * f + j);
+                                     if(tri.is_border_face(twn))
+                                     {
+                                         continue;
+                                     }
+                                     auto expected = INVALID_INDEX;
+                                     if(distances[twn / 3].compare_exchange_strong(
+                                            expected, level + 1, std::memory_order_relaxed))
+                                     {
+                                         next_frontiers[t].push_back(twn / 3);
+                                     }
+                                 }
+                             }
+                         }
+                     });
+        for(const auto& next : next_frontiers)
+        {
+            result.faces.insert(result.faces.end(), next.begin(), next.end());
+        }
+    }
+
+    result.distances.resize(n_faces);
+    for(index f = 0; f < n_faces; ++f)
+    {
+        result.distances[f] = distances[f].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+namespace {
+
+// compact triangulation made of the given faces of tri, vertices in the order of their first use
+template<triangulation_like M>
+Triangulation build_from_faces(const M& tri, const std::vector<index>& face_ids)
+{
+    std::unordered_map<index, index> vertex_map;
+    std::vector<vertex> vertices;
+    std::vector<index> faces;
+    faces.reserve(3 * face_ids.size());
+    for(const auto f : face_ids)
+    {
+        for(std::size_t j = 0; j < 3; ++j)
+        {
+            const auto v = tri.origin(3 * f + j);
+            const auto [it, inserted] = vertex_map.try_emplace(v, vertices.size());
+            if(inserted)
+            {
+                vertices.emplace_back(tri.get_PointX(v), tri.get_PointY(v));
+            }
+            faces.push_back(it->second);
+        }
+    }
+    return {std::move(vertices), faces};
+}
+
+}
+
+template<triangulation_like M>
+Triangulation extract_component(const M& tri, const face_components& components, index component)
+{
+    std::vector<index> face_ids;
+    for(index f = 0; f < components.labels.size(); ++f)
+    {
+        if(components.labels[f] == component)
+        {
+            face_ids.push_back(f);
+        }
+    }
+    return build_from_faces(tri, face_ids);
+}
+
+template<triangulation_like M>
+std::vector<Triangulation> split_components(const M& tri, std::size_t threads)
+{
+    const auto components = label_face_components(tri, threads);
+    std::vector<std::vector<index>> buckets(components.count);
+    for(index f = 0; f < components.labels.size(); ++f)
+    {
+        if(components.labels[f] != INVALID_INDEX)
+        {
+            buckets[components.labels[f]].push_back(f);
+        }
+    }
+    std::vector<std::optional<Triangulation>> parts(components.count);
+    parallel_for(components.count,
+                 threads,
+                 [&tri, &buckets, &parts](std::size_t begin, std::size_t end)
+                 {
+                     for(auto c = begin; c < end; ++c)
+                     {
+                         parts[c].emplace(build_from_faces(tri, buckets[c]));
+                     }
+                 });
+    std::vector<Triangulation> result;
+    result.reserve(components.count);
+    for(auto& part : parts)
+    {
+        result.push_back(std::move(*part));
+    }
+    return result;
+}
+
+template face_components label_face_components(const Triangulation&, std::size_t);
+template face_components label_face_components(const triangulation_view&, std::size_t);
+template face_components label_face_components(const versioned_triangulation::snapshot&, std::size_t);
+template face_components label_face_components(const half_edge_mesh&, std::size_t);
+template face_components label_face_components(const corner_table_mesh&, std::size_t);
+template dual_bfs_result dual_bfs(const Triangulation&, const std::vector<index>&, std::size_t);
+template dual_bfs_result dual_bfs(const triangulation_view&, const std::vector<index>&, std::size_t);
+template dual_bfs_result dual_bfs(const versioned_triangulation::snapshot&, const std::vector<index>&, std::size_t);
+template dual_bfs_result dual_bfs(const half_edge_mesh&, const std::vector<index>&, std::size_t);
+template dual_bfs_result dual_bfs(const corner_table_mesh&, const std::vector<index>&, std::size_t);
+template Triangulation extract_component(const Triangulation&, const face_components&, index);
+template Triangulation extract_component(const triangulation_view&, const face_components&, index);
+template Triangulation extract_component(const versioned_triangulation::snapshot&, const face_components&, index);
+template Triangulation extract_component(const half_edge_mesh&, const face_components&, index);
+template Triangulation extract_component(const corner_table_mesh&, const face_components&, index);
+template std::vector<Triangulation> split_components(const Triangulation&, std::size_t);
+template std::vector<Triangulation> split_components(const triangulation_view&, std::size_t);
+template std::vector<Triangulation> split_components(const versioned_triangulation::snapshot&, std::size_t);
+template std::vector<Triangulation> split_components(const half_edge_mesh&, std::size_t);
+template std::vector<Triangulation> split_components(const corner_table_mesh&, std::size_t);
+
+}
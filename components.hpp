@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Triangulation.hpp"
+#include "triangulation_view.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace half_edge {
+
+/// Labelling of the faces by connected component, two faces are connected if they share an interior edge
+struct face_components
+{
+    /// component of each face slot, INVALID_INDEX for the released faces; components are numbered from 0 in the
+    /// order of their smallest face
+    std::vector<index> labels{};
+    /// number of components
+    std::size_t count{0};
+};
+
+/// Breadth-first traversal of the dual graph, faces adjacent through an interior edge are one step apart
+struct dual_bfs_result
+{
+    /// number of steps from the closest source for each face slot, INVALID_INDEX if unreachable
+    std::vector<index> distances{};
+    /// the faces at distance d are faces[layer_offsets[d]] up to faces[layer_offsets[d + 1]]
+    std::vector<index> layer_offsets{};
+    std::vector<index> faces{};
+};
+
+/**
+ * Labels the connected components of the faces with a lock-free union-find over the interior twin links.
+ * The functions of this file are instantiated for Triangulation, triangulation_view, the versioned snapshots and the
+ * basic_triangulation meshes.
+ * @param[in] tri The triangulation
+ * @param[in] threads The number of worker threads, 0 for the hardware concurrency
+ * @return the component of every face
+ */
+template<triangulation_like M>
+[[nodiscard]] face_components label_face_components(const M& tri, std::size_t threads = 0);
+
+/**
+ * Traverses the dual graph level by level, each frontier is expanded in parallel.
+ * @param[in] tri The triangulation
+ * @param[in] sources The faces at distance 0
+ * @param[in] threads The number of worker threads, 0 for the hardware concurrency
+ * @return the distance of every face and the faces grouped by layer
+ */
+template<triangulation_like M>
+[[nodiscard]] dual_bfs_result dual_bfs(const M& tri, const std::vector<index>& sources, std::size_t threads = 0);
+
+/**
+ * Copies the faces of one component into a new compact triangulation.
+ * @param[in] tri The triangulation
+ * @param[in] components The labelling of the faces of tri
+ * @param[in] component The component to extract
+ * @return the triangulation made of the faces of the component, vertices in the order of their first use
+ */
+template<triangulation_like M>
+[[nodiscard]] Triangulation extract_component(const M& tri, const face_components& components, index component);
+
+/**
+ * Splits the triangulation in one compact triangulation per connected component, built in parallel.
+ * @param[in] tri The triangulation
+ * @param[in] threads The number of worker threads, 0 for the hardware concurrency
+ * @return the components ordered by label
+ */
+template<triangulation_like M>
+[[nodiscard]] std::vector<Triangulation> split_components(const M& tri, std::size_t threads = 0);
+
+}
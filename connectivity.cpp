@@ -0,0 +1,53 @@
+#include "connectivity.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+namespace half_edge {
+
+dense_connectivity make_dense_connectivity(const Triangulation& tri)
+{
+    // the compaction of a copy renumbers the live elements, faces first then the exterior halfedges
+    auto compacted = tri;
+    compacted.compact();
+    const auto vertices = compacted.vertex_storage();
+    const auto half_edges = compacted.halfEdge_storage();
+    return {{vertices.begin(), vertices.end()}, {half_edges.begin(), half_edges.end()}, compacted.faces_size()};
+}
+
+template<>
+half_edge_connectivity make_connectivity<half_edge_connectivity>(const dense_connectivity& dense)
+{
+    return {dense.half_edges, dense.n_faces};
+}
+
+template<>
+corner_table_connectivity make_connectivity<corner_table_connectivity>(const dense_connectivity& dense)
+{
+    if(dense.half_edges.size() > std::numeric_limits<std::uint32_t>::max() ||
+       dense.vertices.size() > std::numeric_limits<std::uint32_t>::max())
+    {
+        throw std::invalid_argument("the corner table stores 32-bit indices");
+    }
+    const auto n_corners = 3 * dense.n_faces;
+    std::vector<std::uint32_t> corner_vertices(n_corners);
+    std::vector<std::uint32_t> corner_twins(n_corners);
+    for(index c = 0; c < n_corners; ++c)
+    {
+        corner_vertices[c] = static_cast<std::uint32_t>(dense.half_edges[c].origin);
+        corner_twins[c] = static_cast<std::uint32_t>(dense.half_edges[c].twin);
+    }
+    std::vector<corner_table_connectivity::exterior> exteriors;
+    exteriors.reserve(dense.half_edges.size() - n_corners);
+    for(auto e = n_corners; e < dense.half_edges.size(); ++e)
+    {
+        const auto& he = dense.half_edges[e];
+        exteriors.push_back({static_cast<std::uint32_t>(he.origin),
+                             static_cast<std::uint32_t>(he.twin),
+                             static_cast<std::uint32_t>(he.next),
+                             static_cast<std::uint32_t>(he.prev)});
+    }
+    return {std::move(corner_vertices), std::move(corner_twins), std::move(exteriors)};
+}
+
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "Triangulation.hpp"
+#include "triangulation_view.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace half_edge {
+
+/// Connectivity of a compact triangle mesh: the interior halfedges of face f are 3f, 3f+1 and 3f+2 and the
+/// exterior halfedges follow them
+template<class C>
+concept connectivity_backend = requires(const C& c, index e) {
+    { c.origin(e) } -> std::convertible_to<index>;
+    { c.twin(e) } -> std::convertible_to<index>;
+    { c.next(e) } -> std::convertible_to<index>;
+    { c.prev(e) } -> std::convertible_to<index>;
+    { c.is_border_face(e) } -> std::convertible_to<bool>;
+    { c.halfEdges_size() } -> std::convertible_to<std::size_t>;
+    { c.memory_bytes() } -> std::convertible_to<std::size_t>;
+};
+
+/// Explicit halfedge records, as stored by Triangulation
+class half_edge_connectivity
+{
+  public:
+    half_edge_connectivity(std::vector<half_edge> half_edges, std::size_t faces_count)
+        : m_half_edges(std::move(half_edges)), n_faces(faces_count)
+    {
+    }
+
+    [[nodiscard]] index origin(index e) const { return m_half_edges[e].origin; }
+    [[nodiscard]] index twin(index e) const { return m_half_edges[e].twin; }
+    [[nodiscard]] index next(index e) const { return m_half_edges[e].next; }
+    [[nodiscard]] index prev(index e) const { return m_half_edges[e].prev; }
+    [[nodiscard]] bool is_border_face(index e) const { return m_half_edges[e].is_border; }
+    [[nodiscard]] std::size_t halfEdges_size() const { return m_half_edges.size(); }
+    [[nodiscard]] std::size_t faces_size() const { return n_faces; }
+    [[nodiscard]] std::size_t memory_bytes() const { return m_half_edges.size() * sizeof(half_edge); }
+
+  private:
+    std::vector<half_edge> m_half_edges;
+    std::size_t n_faces;
+};
+
+/**
+ * Corner table: one vertex and one twin per corner, i.e. per interior halfedge, next and prev follow from the
+ * position in the face. The twin plays the role of the opposite corner of the classic layout. Only the exterior
+ * halfedges, which have no face, keep explicit records. Indices are stored on 32 bits.
+ */
+class corner_table_connectivity
+{
+  public:
+    struct exterior
+    {
+        std::uint32_t origin;
+        std::uint32_t twin;
+        std::uint32_t next;
+        std::uint32_t prev;
+    };
+
+    corner_table_connectivity(std::vector<std::uint32_t> corner_vertices,
+                              std::vector<std::uint32_t> corner_twins,
+                              std::vector<exterior> exteriors)
+        : m_corner_vertices(std::move(corner_vertices)), m_corner_twins(std::move(corner_twins)),
+          m_exteriors(std::move(exteriors)), n_corners(m_corner_vertices.size())
+    {
+    }
+
+    [[nodiscard]] index origin(index e) const
+    {
+        return e < n_corners ? m_corner_vertices[e] : m_exteriors[e - n_corners].origin;
+    }
+    [[nodiscard]] index twin(index e) const
+    {
+        return e < n_corners ? m_corner_twins[e] : m_exteriors[e - n_corners].twin;
+    }
+    [[nodiscard]] index next(index e) const
+    {
+        if(e < n_corners)
+        {
+            return e % 3 == 2 ? e - 2 : e + 1;
+        }
+        return m_exteriors[e - n_corners].next;
+    }
+    [[nodiscard]] index prev(index e) const
+    {
+        if(e < n_corners)
+        {
+            return e % 3 == 0 ? e + 2 : e - 1;
+        }
+        return m_exteriors[e - n_corners].prev;
+    }
+    [[nodiscard]] bool is_border_face(index e) const { return e >= n_corners; }
+    [[nodiscard]] std::size_t halfEdges_size() const { return n_corners + m_exteriors.size(); }
+    [[nodiscard]] std::size_t faces_size() const { return n_corners / 3; }
+    [[nodiscard]] std::size_t memory_bytes() const
+    {
+        return (m_corner_vertices.size() + m_corner_twins.size()) * sizeof(std::uint32_t) +
+               m_exteriors.size() * sizeof(exterior);
+    }
+
+  private:
+    std::vector<std::uint32_t> m_corner_vertices;
+    std::vector<std::uint32_t> m_corner_twins;
+    std::vector<exterior> m_exteriors;
+    std::size_t n_corners;
+};
+
+/// Live elements of a triangulation renumbered densely: faces first, then the exterior halfedges
+struct dense_connectivity
+{
+    std::vector<vertex> vertices{};
+    /// renumbered halfedges, records of released slots are dropped
+    std::vector<half_edge> half_edges{};
+    std::size_t n_faces{0};
+};
+
+/**
+ * Renumbers the live elements of a triangulation as Triangulation::compact() does, on a copy.
+ * @param[in] tri The triangulation
+ * @return the vertices and halfedges with dense indices
+ */
+[[nodiscard]] dense_connectivity make_dense_connectivity(const Triangulation& tri);
+
+/**
+ * Builds a connectivity backend from a triangulation.
+ * @param[in] dense The dense renumbering of the triangulation
+ * @return the backend
+ */
+template<connectivity_backend C>
+[[nodiscard]] C make_connectivity(const dense_connectivity& dense);
+
+template<>
+[[nodiscard]] half_edge_connectivity make_connectivity<half_edge_connectivity>(const dense_connectivity& dense);
+
+template<>
+[[nodiscard]] corner_table_connectivity make_connectivity<corner_table_connectivity>(const dense_connectivity& dense);
+
+/**
+ * Read-only triangle mesh with the accessors of Triangulation over a connectivity backend chosen at compile time,
+ * the calls are forwarded inline without any virtual dispatch. It has no released slot.
+ */
+template<connectivity_backend C>
+class basic_triangulation : public triangulation_accessors<basic_triangulation<C>>
+{
+  public:
+    explicit basic_triangulation(const Triangulation& tri) : basic_triangulation(make_dense_connectivity(tri)) {}
+
+    explicit basic_triangulation(dense_connectivity dense)
+        : m_connectivity(make_connectivity<C>(dense)), m_vertices(std::move(dense.vertices))
+    {
+    }
+
+    [[nodiscard]] auto faces_size() const { return m_connectivity.faces_size(); }
+    [[nodiscard]] auto halfEdges_size() const { return m_connectivity.halfEdges_size(); }
+    [[nodiscard]] auto vertices_size() const { return m_vertices.size(); }
+    [[nodiscard]] auto halfEdge_slots() const { return m_connectivity.halfEdges_size(); }
+    [[nodiscard]] auto vertex_slots() const { return m_vertices.size(); }
+
+    [[nodiscard]] const C& connectivity() const { return m_connectivity; }
+    // bytes used by the connectivity and the vertices
+    [[nodiscard]] std::size_t memory_bytes() const
+    {
+        return m_connectivity.memory_bytes() + m_vertices.size() * sizeof(vertex);
+    }
+
+  private:
+    friend class triangulation_accessors<basic_triangulation<C>>;
+
+    [[nodiscard]] const vertex& vertex_at(index v) const { return m_vertices[v]; }
+    // the record of the halfedge assembled from the backend, the fields the caller does not read are optimized out
+    [[nodiscard]] half_edge half_edge_at(index e) const
+    {
+        half_edge he;
+        he.origin = m_connectivity.origin(e);
+        he.twin = m_connectivity.twin(e);
+        he.next = m_connectivity.next(e);
+        he.prev = m_connectivity.prev(e);
+        he.is_border = m_connectivity.is_border_face(e);
+        return he;
+    }
+
+    C m_connectivity;
+    std::vector<vertex> m_vertices;
+};
+
+using half_edge_mesh = basic_triangulation<half_edge_connectivity>;
+using corner_table_mesh = basic_triangulation<corner_table_connectivity>;
+
+}
@@ -0,0 +1,313 @@
+#include "decimation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace half_edge {
+
+namespace {
+
+/// weight of the boundary lines relative to the original vertices in the quadrics
+constexpr double BOUNDARY_WEIGHT{100.};
+
+/// symmetric 3x3 quadric of the homogeneous point (x, y, 1)
+struct quadric
+{
+    double xx{};
+    double xy{};
+    double x{};
+    double yy{};
+    double y{};
+    double c{};
+
+    quadric& operator+=(const quadric& q)
+    {
+        xx += q.xx;
+        xy += q.xy;
+        x += q.x;
+        yy += q.yy;
+        y += q.y;
+        c += q.c;
+        return *this;
+    }
+
+    friend quadric operator+(quadric lhs, const quadric& rhs) { return lhs += rhs; }
+
+    [[nodiscard]] double error(double px, double py) const
+    {
+        return xx * px * px + 2 * xy * px * py + 2 * x * px + yy * py * py + 2 * y * py + c;
+    }
+};
+
+// squared distance to the point (px, py)
+quadric point_quadric(double px, double py) { return {1., 0., -px, 1., -py, px * px + py * py}; }
+
+// weighted squared distance to the line through a and b
+quadric line_quadric(double ax, double ay, double bx, double by, double weight)
+{
+    const auto dx = bx - ax;
+    const auto dy = by - ay;
+    const auto len2 = dx * dx + dy * dy;
+    if(len2 <= 0.)
+    {
+        return {};
+    }
+    // normal (nx, ny) of length len and offset d of the line, the weight divides len^2 back out
+    const auto nx = -dy;
+    const auto ny = dx;
+    const auto d = -(nx * ax + ny * ay);
+    const auto w = weight / len2;
+    return {w * nx * nx, w * nx * ny, w * nx * d, w * ny * ny, w * ny * d, w * d * d};
+}
+
+// twice the signed area of the triangle (p, u, w), positive if counterclockwise
+double orientation(double px, double py, double ux, double uy, double wx, double wy)
+{
+    return (ux - px) * (wy - py) - (uy - py) * (wx - px);
+}
+
+struct heap_entry
+{
+    float cost;
+    std::uint32_t stamp;
+    index e;
+};
+
+// ordering of a min-heap on the cost
+constexpr auto costlier = [](const heap_entry& lhs, const heap_entry& rhs) { return lhs.cost > rhs.cost; };
+
+/// best collapse of an edge: the halfedge whose origin is removed and the new position of its target
+struct candidate
+{
+    index h{INVALID_INDEX};
+    double cost{std::numeric_limits<double>::max()};
+    double x{};
+    double y{};
+};
+
+class decimator
+{
+  public:
+    decimator(Triangulation& tri, const decimation_options& options)
+        : m_tri(tri), m_options(options), m_quadrics(tri.vertex_slots()), m_stamps(tri.halfEdge_slots(), 0),
+          m_rejected(tri.halfEdge_slots(), false)
+    {
+        for(index v = 0; v < tri.vertex_slots(); ++v)
+        {
+            if(tri.is_vertex_alive(v))
+            {
+                m_quadrics[v] = point_quadric(tri.get_PointX(v), tri.get_PointY(v));
+            }
+        }
+        for(index e = 0; e < tri.halfEdge_slots(); ++e)
+        {
+            if(tri.is_halfEdge_alive(e) && tri.is_border_face(e))
+            {
+                const auto a = tri.origin(e);
+                const auto b = tri.target(e);
+                const auto line = line_quadric(
+                    tri.get_PointX(a), tri.get_PointY(a), tri.get_PointX(b), tri.get_PointY(b), BOUNDARY_WEIGHT);
+                m_quadrics[a] += line;
+                m_quadrics[b] += line;
+            }
+        }
+        for(index e = 0; e < tri.halfEdge_slots(); ++e)
+        {
+            if(tri.is_halfEdge_alive(e) && e < tri.twin(e))
+            {
+                if(const auto cand = evaluate(e); cand.h != INVALID_INDEX)
+                {
+                    m_heap.push_back({static_cast<float>(cand.cost), 0, e});
+                }
+            }
+        }
+        std::ranges::make_heap(m_heap, costlier);
+    }
+
+    decimation_result run()
+    {
+        decimation_result result;
+        while(!m_heap.empty() && m_tri.faces_size() > m_options.target_faces)
+        {
+            std::ranges::pop_heap(m_heap, costlier);
+            const auto entry = m_heap.back();
+            m_heap.pop_back();
+            // lazy invalidation: the edge changed since the entry was pushed
+            if(!m_tri.is_halfEdge_alive(entry.e) || m_stamps[entry.e] != entry.stamp)
+            {
+                continue;
+            }
+            const auto cand = evaluate(entry.e);
+            if(cand.cost > m_options.max_error)
+            {
+                break;
+            }
+            if(cand.h == INVALID_INDEX || !m_tri.is_collapse_ok(cand.h) || folds_over(cand))
+            {
+                // parked until a collapse changes the one-ring of one of its vertices
+                m_rejected[entry.e] = true;
+                m_rejected[m_tri.twin(entry.e)] = true;
+                continue;
+            }
+            const auto a = m_tri.origin(cand.h);
+            const auto b = m_tri.target(cand.h);
+            m_quadrics[b] += m_quadrics[a];
+            m_tri.collapse_edge(cand.h);
+            m_tri.set_point(b, cand.x, cand.y);
+            ++result.collapses;
+            result.max_error = std::max(result.max_error, cand.cost);
+
+            // the costs of the edges around b changed, and so did the one-rings of its neighbours
+            const auto start = m_tri.edge_of_vertex(b);
+            auto e = start;
+            do
+            {
+                push(e);
+                requeue_rejected(m_tri.target(e));
+                e = m_tri.CCW_edge_to_vertex(e);
+            } while(e != start);
+        }
+        result.map = m_tri.compact();
+        return result;
+    }
+
+  private:
+    [[nodiscard]] candidate evaluate(index e) const
+    {
+        candidate best;
+        const std::array<index, 2> directions{e, m_tri.twin(e)};
+        for(const auto h : directions)
+        {
+            const auto a = m_tri.origin(h);
+            const auto b = m_tri.target(h);
+            const auto border_a = m_tri.is_border_vertex(a);
+            const auto border_b = m_tri.is_border_vertex(b);
+            if(m_options.keep_boundary && border_a)
+            {
+                continue;
+            }
+            const auto ax = m_tri.get_PointX(a);
+            const auto ay = m_tri.get_PointY(a);
+            const auto bx = m_tri.get_PointX(b);
+            const auto by = m_tri.get_PointY(b);
+            const auto q = m_quadrics[a] + m_quadrics[b];
+
+            candidate cand{h, 0., 0.5 * (ax + bx), 0.5 * (ay + by)};
+            if(m_options.keep_boundary && border_b)
+            {
+                cand.x = bx;
+                cand.y = by;
+            }
+            else if(m_options.metric == decimation_metric::quadric)
+            {
+                // minimum of the quadric, the point quadrics make it positive definite
+                if(const auto det = q.xx * q.yy - q.xy * q.xy; det > 0.)
+                {
+                    cand.x = (q.xy * q.y - q.x * q.yy) / det;
+                    cand.y = (q.xy * q.x - q.y * q.xx) / det;
+                }
+            }
+            else if(border_a != border_b)
+            {
+                cand.x = border_a ? ax : bx;
+                cand.y = border_a ? ay : by;
+            }
+
+            if(m_options.metric == decimation_metric::quadric)
+            {
+                cand.cost = q.error(cand.x, cand.y);
+            }
+            else
+            {
+                cand.cost = (ax - bx) * (ax - bx) + (ay - by) * (ay - by);
+            }
+            if(cand.cost < best.cost)
+            {
+                best = cand;
+            }
+        }
+        return best;
+    }
+
+    // whether moving the vertices of the collapse to the new position turns a remaining triangle over
+    [[nodiscard]] bool folds_over(const candidate& cand) const
+    {
+        const auto check_fan = [this, &cand](index start, index other)
+        {
+            auto g = start;
+            do
+            {
+                if(!m_tri.is_border_face(g))
+                {
+                    const auto u = m_tri.target(g);
+                    const auto w = m_tri.origin(m_tri.prev(g));
+                    if(u != other && w != other &&
+                       orientation(cand.x,
+                                   cand.y,
+                                   m_tri.get_PointX(u),
+                                   m_tri.get_PointY(u),
+                                   m_tri.get_PointX(w),
+                                   m_tri.get_PointY(w)) <= 0.)
+                    {
+                        return true;
+                    }
+                }
+                g = m_tri.CCW_edge_to_vertex(g);
+            } while(g != start);
+            return false;
+        };
+        const auto t = m_tri.twin(cand.h);
+        return check_fan(cand.h, m_tri.origin(t)) || check_fan(t, m_tri.origin(cand.h));
+    }
+
+    // pushes back the rejected edges around v
+    void requeue_rejected(index v)
+    {
+        const auto start = m_tri.edge_of_vertex(v);
+        auto e = start;
+        do
+        {
+            if(m_rejected[e])
+            {
+                push(e);
+            }
+            e = m_tri.CCW_edge_to_vertex(e);
+        } while(e != start);
+    }
+
+    void push(index e)
+    {
+        const auto t = m_tri.twin(e);
+        ++m_stamps[e];
+        ++m_stamps[t];
+        m_rejected[e] = false;
+        m_rejected[t] = false;
+        if(const auto cand = evaluate(e); cand.h != INVALID_INDEX)
+        {
+            m_heap.push_back({static_cast<float>(cand.cost), m_stamps[e], e});
+            std::ranges::push_heap(m_heap, costlier);
+        }
+    }
+
+    Triangulation& m_tri;
+    const decimation_options& m_options;
+    /// accumulated quadric of each vertex
+    std::vector<quadric> m_quadrics;
+    /// version of each halfedge, bumped when the cost of its edge changes
+    std::vector<std::uint32_t> m_stamps;
+    /// whether the edge of each halfedge was popped but could not be collapsed
+    std::vector<bool> m_rejected;
+    std::vector<heap_entry> m_heap{};
+};
+
+}
+
+decimation_result decimate(Triangulation& tri, const decimation_options& options)
+{
+    decimator dec(tri, options);
+    return dec.run();
+}
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Triangulation.hpp"
+
+#include <cstddef>
+#include <limits>
+
+namespace half_edge {
+
+/// Cost driving the order of the collapses
+enum class decimation_metric
+{
+    /// squared distance to the boundary lines and to the original vertices merged so far
+    quadric,
+    /// squared edge length
+    edge_length
+};
+
+struct decimation_options
+{
+    /// stop once the triangulation has at most this number of faces
+    std::size_t target_faces{0};
+    /// stop once the cheapest collapse costs more than this
+    double max_error{std::numeric_limits<double>::max()};
+    decimation_metric metric{decimation_metric::quadric};
+    /// never remove nor move the boundary vertices
+    bool keep_boundary{false};
+};
+
+struct decimation_result
+{
+    /// number of collapsed edges
+    std::size_t collapses{0};
+    /// largest cost among the collapses done
+    double max_error{0};
+    /// old to new indices of the compaction done at the end
+    compaction_map map{};
+};
+
+/**
+ * Decimates the triangulation in place by collapsing its cheapest edges first, then compacts it.
+ * The collapses keep the triangulation manifold (link condition) and never fold a triangle over.
+ *
+ * @param[in,out] tri The triangulation to decimate
+ * @param[in] options The stopping criteria and the cost of the collapses
+ * @return the number of collapses and the index maps of the final compaction
+ */
+decimation_result decimate(Triangulation& tri, const decimation_options& options);
+
+}
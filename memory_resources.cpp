@@ -0,0 +1,84 @@
+#include "memory_resources.hpp"
+
+#include <cstdint>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HE_HUGEPAGE_MMAP 1
+#include <sys/mman.h>
+#endif
+
+namespace half_edge {
+
+namespace {
+
+constexpr std::size_t round_up(std::size_t bytes)
+{
+    return (bytes + hugepage_resource::HUGE_PAGE_SIZE - 1) / hugepage_resource::HUGE_PAGE_SIZE *
+           hugepage_resource::HUGE_PAGE_SIZE;
+}
+
+constexpr bool is_mapped([[maybe_unused]] std::size_t bytes, [[maybe_unused]] std::size_t alignment)
+{
+#if defined(HE_HUGEPAGE_MMAP)
+    return bytes >= hugepage_resource::HUGE_PAGE_SIZE && alignment <= hugepage_resource::HUGE_PAGE_SIZE;
+#else
+    return false;
+#endif
+}
+
+}
+
+void* hugepage_resource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    if(!is_mapped(bytes, alignment))
+    {
+        return m_upstream->allocate(bytes, alignment);
+    }
+#if defined(HE_HUGEPAGE_MMAP)
+    // map one more huge page and trim both ends so that the block starts on a huge page boundary
+    const auto size = round_up(bytes);
+    auto* address = ::mmap(nullptr, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if(address == MAP_FAILED)
+    {
+        throw std::bad_alloc();
+    }
+    const auto start = reinterpret_cast<std::uintptr_t>(address);
+    const auto aligned = (start + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    if(aligned != start)
+    {
+        ::munmap(address, aligned - start);
+    }
+    if(const auto tail = HUGE_PAGE_SIZE - (aligned - start); tail != 0)
+    {
+        ::munmap(reinterpret_cast<void*>(aligned + size), tail);
+    }
+    auto* block = reinterpret_cast<void*>(aligned);
+#if defined(MADV_HUGEPAGE)
+    ::madvise(block, size, MADV_HUGEPAGE);
+#endif
+    return block;
+#else
+    return nullptr;
+#endif
+}
+
+void hugepage_resource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+{
+    if(!is_mapped(bytes, alignment))
+    {
+        m_upstream->deallocate(p, bytes, alignment);
+        return;
+    }
+#if defined(HE_HUGEPAGE_MMAP)
+    ::munmap(p, round_up(bytes));
+#endif
+}
+
+bool hugepage_resource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    const auto* resource = dynamic_cast<const hugepage_resource*>(&other);
+    return resource != nullptr && resource->m_upstream->is_equal(*m_upstream);
+}
+
+}
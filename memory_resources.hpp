@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace half_edge {
+
+/**
+ * Memory resource for the large arrays of big meshes, e.g. as the storage of build_resources. The blocks of at least
+ * HUGE_PAGE_SIZE bytes are anonymous mappings aligned on huge pages and advised for transparent huge pages where the
+ * platform supports it; the smaller blocks, and all of them without mmap, come from the upstream resource.
+ */
+class hugepage_resource : public std::pmr::memory_resource
+{
+  public:
+    static constexpr std::size_t HUGE_PAGE_SIZE = std::size_t{2} << 20U;
+
+    explicit hugepage_resource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : m_upstream(upstream) {}
+
+    [[nodiscard]] std::pmr::memory_resource* upstream_resource() const { return m_upstream; }
+
+  private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    std::pmr::memory_resource* m_upstream;
+};
+
+}
@@ -1,12 +1,75 @@
 #include "model_io.hpp"
 
+#include <charconv>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
-#include <sstream>
 #include <string>
+#include <system_error>
 
 namespace half_edge {
 
+namespace {
+
+std::string_view skip_spaces(std::string_view s)
+{
+    while(!s.empty() && is_space_char(s.front()))
+    {
+        s.remove_prefix(1);
+    }
+    return s;
+}
+
+// from_chars rejects the plus sign that the stream extraction accepts
+std::string_view skip_plus(std::string_view s)
+{
+    if(s.size() > 1 && s.front() == '+' && s[1] != '+' && s[1] != '-')
+    {
+        s.remove_prefix(1);
+    }
+    return s;
+}
+
+}
+
+[[nodiscard]]
+bool parse_next(std::string_view& s, long long& value)
+{
+    const auto text = skip_plus(skip_spaces(s));
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if(error != std::errc{})
+    {
+        return false;
+    }
+    s.remove_prefix(static_cast<std::size_t>(end - s.data()));
+    return true;
+}
+
+[[nodiscard]]
+bool parse_next(std::string_view& s, double& value)
+{
+    const auto text = skip_plus(skip_spaces(s));
+#if defined(__cpp_lib_to_chars)
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if(error != std::errc{})
+    {
+        return false;
+    }
+    s.remove_prefix(static_cast<std::size_t>(end - s.data()));
+#else
+    // the floating point from_chars is missing, strtod needs a terminated copy of the token
+    const std::string token(text.begin(), std::ranges::find_if(text, is_space_char));
+    char* end = nullptr;
+    value = std::strtod(token.c_str(), &end);
+    if(end == token.c_str())
+    {
+        return false;
+    }
+    s.remove_prefix(static_cast<std::size_t>(text.data() - s.data()) + static_cast<std::size_t>(end - token.c_str()));
+#endif
+    return true;
+}
+
 [[nodiscard]]
 bool has_valid_off_header(std::istream& off_file)
 {
@@ -38,9 +101,8 @@ std::pair<std::size_t, std::size_t> parse_num_vertex_face(std::istream& off_file
         }
         long long n_vertices{0};
         long long n_faces{0};
-        auto istr = std::istringstream(line);
-        istr >> n_vertices >> n_faces;
-        if(istr.fail())
+        std::string_view text = line;
+        if(!parse_next(text, n_vertices) || !parse_next(text, n_faces))
         {
             throw std::invalid_argument("failed to parse the number of vertices and faces");
         }
@@ -69,9 +131,8 @@ std::pair<std::size_t, std::size_t> parse_num_vertex_face(std::istream& off_file
         double a1{.0};
         double a2{.0};
         double a3{.0};
-        auto istr = std::istringstream(line);
-        istr >> a1 >> a2 >> a3;
-        if(istr.fail())
+        std::string_view text = line;
+        if(!parse_next(text, a1) || !parse_next(text, a2) || !parse_next(text, a3))
         {
             throw std::invalid_argument("failed to parse the vertices");
         }
@@ -84,14 +145,13 @@ std::pair<std::size_t, std::size_t> parse_num_vertex_face(std::istream& off_file
 [[nodiscard]]
 std::array<index, 3> parse_face(const std::string& line)
 {
-    std::istringstream iss(line);
+    std::string_view text = line;
     std::array<index, 3> face{};
 
     for(auto& vertex_idx : face)
     {
-        long long tmp;
-        iss >> tmp;
-        if(iss.fail())
+        long long tmp{0};
+        if(!parse_next(text, tmp))
         {
             throw std::invalid_argument("failed to parse the faces: " + line);
         }
@@ -101,8 +161,8 @@ std::array<index, 3> parse_face(const std::string& line)
         }
         vertex_idx = static_cast<index>(tmp);
     }
-    // if there are still characters in the stream, it means that the input is not good
-    if(!iss.eof())
+    // if there are still characters in the line, it means that the input is not good
+    if(!text.empty())
     {
             throw std::invalid_argument("invalid input string: " + line);
     }
@@ -63,6 +63,25 @@ constexpr bool is_line_to_skip(std::string_view s) noexcept
     return is_comment_line(s) || contains_only_whitespaces(s);
 }
 
+/**
+ * Parses the number at the beginning of a string after its leading whitespaces, as the stream extraction operator
+ * does but without allocating.
+ * @param[in,out] s The string view, the whitespaces and the number are removed from its beginning
+ * @param[out] value The number
+ * @return true if a number was parsed, false otherwise and s is left unchanged
+ */
+[[nodiscard]]
+bool parse_next(std::string_view& s, long long& value);
+
+/**
+ * Parses the floating point number at the beginning of a string after its leading whitespaces.
+ * @param[in,out] s The string view, the whitespaces and the number are removed from its beginning
+ * @param[out] value The number
+ * @return true if a number was parsed, false otherwise and s is left unchanged
+ */
+[[nodiscard]]
+bool parse_next(std::string_view& s, double& value);
+
 [[nodiscard]]
 bool has_valid_off_header(std::istream& off_file);
 
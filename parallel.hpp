@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace half_edge {
+
+/**
+ * Resolves the number of worker threads to use.
+ * @param[in] requested The requested number of threads, 0 for the hardware concurrency
+ * @param[in] work The number of work items, no more threads than items are used
+ * @return the number of threads, at least 1
+ */
+inline std::size_t resolve_threads(std::size_t requested, std::size_t work)
+{
+    const std::size_t hardware = std::max(1U, std::thread::hardware_concurrency());
+    const auto n = requested == 0 ? hardware : requested;
+    return std::max<std::size_t>(1, std::min(n, work));
+}
+
+/**
+ * Splits [0, n) in contiguous chunks, one per thread, and calls f(begin, end) on each of them concurrently.
+ * The calling thread processes the first chunk.
+ * @param[in] n The number of items
+ * @param[in] threads The requested number of threads, 0 for the hardware concurrency
+ * @param[in] f The callable processing the items [begin, end)
+ */
+template<class F>
+void parallel_for(std::size_t n, std::size_t threads, F&& f)
+{
+    const auto n_threads = resolve_threads(threads, n);
+    const auto chunk = (n + n_threads - 1) / n_threads;
+    std::vector<std::jthread> workers;
+    workers.reserve(n_threads - 1);
+    for(std::size_t t = 1; t < n_threads; ++t)
+    {
+        const auto begin = std::min(n, t * chunk);
+        const auto end = std::min(n, begin + chunk);
+        workers.emplace_back([&f, begin, end] { f(begin, end); });
+    }
+    f(std::size_t{0}, std::min(n, chunk));
+}
+
+}
@@ -0,0 +1,460 @@
+#include "partition.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <utility>
+
+namespace half_edge {
+
+namespace {
+
+constexpr std::uint32_t CURVE_BITS = 16;
+constexpr std::uint32_t CURVE_SIDE = 1U << CURVE_BITS;
+
+// spread the 16 low bits of x over the even bits
+std::uint64_t part1by1(std::uint64_t x)
+{
+    x &= 0xFFFFU;
+    x = (x | (x << 8U)) & 0x00FF00FFU;
+    x = (x | (x << 4U)) & 0x0F0F0F0FU;
+    x = (x | (x << 2U)) & 0x33333333U;
+    x = (x | (x << 1U)) & 0x55555555U;
+    return x;
+}
+
+std::uint64_t morton_key(std::uint32_t x, std::uint32_t y)
+{
+    return part1by1(x) | (part1by1(y) << 1U);
+}
+
+std::uint64_t hilbert_key(std::uint32_t x, std::uint32_t y)
+{
+    std::uint64_t d = 0;
+    for(auto s = CURVE_SIDE / 2; s > 0; s /= 2)
+    {
+        const auto rx = (x & s) > 0 ? 1U : 0U;
+        const auto ry = (y & s) > 0 ? 1U : 0U;
+        d += std::uint64_t{s} * s * ((3U * rx) ^ ry);
+        // rotate the quadrant so that the curve enters it at its origin
+        if(ry == 0)
+        {
+            if(rx == 1)
+            {
+                x = CURVE_SIDE - 1 - x;
+                y = CURVE_SIDE - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+// curve keys of the centroids of the live faces, sorted
+std::vector<std::pair<std::uint64_t, index>> sorted_face_keys(const Triangulation& tri,
+                                                              const partition_options& options)
+{
+    std::vector<index> faces;
+    faces.reserve(tri.faces_size());
+    auto min_x = std::numeric_limits<double>::max();
+    auto min_y = std::numeric_limits<double>::max();
+    auto max_x = std::numeric_limits<double>::lowest();
+    auto max_y = std::numeric_limits<double>::lowest();
+    for(index f = 0; f < tri.face_slots(); ++f)
+    {
+        if(!tri.is_face_alive(f))
+        {
+            continue;
+        }
+        faces.push_back(f);
+        for(std::size_t j = 0; j < 3; ++j)
+        {
+            const auto v = tri.origin(3 * f + j);
+            min_x = std::min(min_x, tri.get_PointX(v));
+            min_y = std::min(min_y, tri.get_PointY(v));
+            max_x = std::max(max_x, tri.get_PointX(v));
+            max_y = std::max(max_y, tri.get_PointY(v));
+        }
+    }
+    const auto extent = std::max(max_x - min_x, max_y - min_y);
+    const auto scale = extent > 0 ? (CURVE_SIDE - 1) / extent : 0.;
+
+    std::vector<std::pair<std::uint64_t, index>> keys(faces.size());
+    parallel_for(faces.size(),
+                 options.threads,
+                 [&](std::size_t begin, std::size_t end)
+                 {
+                     for(auto k = begin; k < end; ++k)
+                     {
+                         const auto f = faces[k];
+                         auto cx = 0.;
+                         auto cy = 0.;
+                         for(std::size_t j = 0; j < 3; ++j)
+                         {
+                             cx += tri.get_PointX(tri.origin(3 * f + j));
+                             cy += tri.get_PointY(tri.origin(3 * f + j));
+                         }
+                         const auto qx = static_cast<std::uint32_t>(std::lround((cx / 3 - min_x) * scale));
+                         const auto qy = static_cast<std::uint32_t>(std::lround((cy / 3 - min_y) * scale));
+                         const auto key = options.curve == space_filling_curve::hilbert ? hilbert_key(qx, qy)
+                                                                                        : morton_key(qx, qy);
+                         keys[k] = {key, f};
+                     }
+                 });
+    std::ranges::sort(keys);
+    return keys;
+}
+
+// greedy sweeps moving a face of a cut to the part holding most of its neighbours, within the size bounds
+void refine_cuts(const Triangulation& tri, const partition_options& options, std::vector<index>& face_parts)
+{
+    std::vector<std::size_t> sizes(options.parts, 0);
+    for(const auto p : face_parts)
+    {
+        if(p != INVALID_INDEX)
+        {
+            ++sizes[p];
+        }
+    }
+    const auto ideal = static_cast<double>(tri.faces_size()) / static_cast<double>(options.parts);
+    const auto max_size = static_cast<std::size_t>(std::ceil(ideal * (1 + options.imbalance)));
+    const auto min_size = static_cast<std::size_t>(std::floor(ideal * (1 - options.imbalance)));
+
+    for(std::size_t pass = 0; pass < options.refinement_passes; ++pass)
+    {
+        std::size_t moves = 0;
+        for(index f = 0; f < face_parts.size(); ++f)
+        {
+            const auto p = face_parts[f];
+            if(p == INVALID_INDEX)
+            {
+                continue;
+            }
+            std::array<index, 3> neighbours{};
+            for(std::size_t j = 0; j < 3; ++j)
+            {
+                const auto t = tri.twin(3 * f + j);
+                neighbours[j] = tri.is_border_face(t) ? INVALID_INDEX : face_parts[t / 3];
+            }
+            auto best = p;
+            std::ptrdiff_t best_gain = 0;
+            for(const auto q : neighbours)
+            {
+                if(q == INVALID_INDEX || q == p)
+                {
+                    continue;
+                }
+                const auto gain = std::ranges::count(neighbours, q) - std::ranges::count(neighbours, p);
+                if(gain > best_gain)
+                {
+                    best = q;
+                    best_gain = gain;
+                }
+            }
+            if(best != p && sizes[best] < max_size && sizes[p] > min_size && sizes[p] > 1)
+            {
+                face_parts[f] = best;
+                --sizes[p];
+                ++sizes[best];
+                ++moves;
+            }
+        }
+        if(moves == 0)
+        {
+            break;
+        }
+    }
+}
+
+// append to added the faces around v to include so that the included ones form a single fan: all the gaps between
+// them but the one on the boundary of the mesh, or else the largest one
+template<class F>
+void close_fan(const Triangulation& tri, index v, const F& is_included, std::vector<index>& added)
+{
+    std::vector<index> ring;
+    const auto start = tri.edge_of_vertex(v);
+    auto e = start;
+    do
+    {
+        ring.push_back(e);
+        e = tri.CCW_edge_to_vertex(e);
+    } while(e != start);
+    const auto inside = [&](index h) { return !tri.is_border_face(h) && is_included(h / 3); };
+    // start the ring on an included face, the gaps are then runs of halfedges not wrapping around
+    const auto first = std::ranges::find_if(ring, inside);
+    if(first == ring.end())
+    {
+        return;
+    }
+    std::ranges::rotate(ring, first);
+    std::vector<std::pair<std::size_t, std::size_t>> gaps;
+    for(std::size_t k = 1; k < ring.size(); ++k)
+    {
+        if(inside(ring[k]))
+        {
+            continue;
+        }
+        if(inside(ring[k - 1]))
+        {
+            gaps.emplace_back(k, k);
+        }
+        gaps.back().second = k + 1;
+    }
+    if(gaps.size() < 2)
+    {
+        return;
+    }
+    const auto kept_rank = [&](const std::pair<std::size_t, std::size_t>& gap)
+    {
+        const auto on_border = std::ranges::any_of(ring.begin() + static_cast<std::ptrdiff_t>(gap.first),
+                                                   ring.begin() + static_cast<std::ptrdiff_t>(gap.second),
+                                                   [&](index h) { return tri.is_border_face(h); });
+        return on_border ? std::numeric_limits<std::size_t>::max() : gap.second - gap.first;
+    };
+    const auto kept = std::ranges::max_element(gaps, {}, kept_rank);
+    for(auto gap = gaps.begin(); gap != gaps.end(); ++gap)
+    {
+        if(gap != kept)
+        {
+            for(auto k = gap->first; k < gap->second; ++k)
+            {
+                added.push_back(ring[k] / 3);
+            }
+        }
+    }
+}
+
+// build the part p from its owned faces, given the vertex to face incidence in CSR form
+mesh_part build_part(const Triangulation& tri,
+                     const mesh_partition& partition,
+                     const std::vector<index>& owned,
+                     const std::vector<index>& incidence_offsets,
+                     const std::vector<index>& incidence,
+                     index p)
+{
+    std::vector<index> ghosts;
+    std::vector<index> touched;
+    for(const auto f : owned)
+    {
+        for(std::size_t j = 0; j < 3; ++j)
+        {
+            const auto v = tri.origin(3 * f + j);
+            for(auto k = incidence_offsets[v]; k < incidence_offsets[v + 1]; ++k)
+            {
+                if(partition.face_parts[incidence[k]] != p)
+                {
+                    ghosts.push_back(incidence[k]);
+                }
+            }
+        }
+    }
+    std::ranges::sort(ghosts);
+    const auto [first, last] = std::ranges::unique(ghosts);
+    ghosts.erase(first, last);
+
+    // the fans of the owned vertices are complete, but a vertex only reached by ghost faces can have several:
+    // fill the gaps between them until every fan is single, so that the part stays manifold
+    const auto is_included = [&](index f)
+    { return partition.face_parts[f] == p || std::ranges::binary_search(ghosts, f); };
+    auto fresh = ghosts;
+    while(!fresh.empty())
+    {
+        std::vector<index> around;
+        for(const auto f : fresh)
+        {
+            for(std::size_t j = 0; j < 3; ++j)
+            {
+                around.push_back(tri.origin(3 * f + j));
+            }
+        }
+        std::ranges::sort(around);
+        const auto [a_first, a_last] = std::ranges::unique(around);
+        around.erase(a_first, a_last);
+        std::vector<index> added;
+        for(const auto v : around)
+        {
+            close_fan(tri, v, is_included, added);
+        }
+        std::ranges::sort(added);
+        const auto [d_first, d_last] = std::ranges::unique(added);
+        added.erase(d_first, d_last);
+        std::erase_if(added, is_included);
+        ghosts.insert(ghosts.end(), added.begin(), added.end());
+        std::ranges::inplace_merge(ghosts, ghosts.end() - static_cast<std::ptrdiff_t>(added.size()));
+        fresh = std::move(added);
+    }
+
+    std::vector<index> face_to_global = owned;
+    face_to_global.insert(face_to_global.end(), ghosts.begin(), ghosts.end());
+    for(const auto f : face_to_global)
+    {
+        for(std::size_t j = 0; j < 3; ++j)
+        {
+            touched.push_back(tri.origin(3 * f + j));
+        }
+    }
+    std::ranges::sort(touched);
+    const auto [t_first, t_last] = std::ranges::unique(touched);
+    touched.erase(t_first, t_last);
+    // owned vertices first, each group in increasing global order
+    const auto ghost_begin = std::ranges::stable_partition(touched, [&](index v)
+                                                           { return partition.vertex_parts[v] == p; });
+
+    const auto owned_vertices = static_cast<std::size_t>(ghost_begin.begin() - touched.begin());
+    std::vector<vertex> vertices;
+    vertices.reserve(touched.size());
+    for(const auto v : touched)
+    {
+        vertices.emplace_back(tri.get_PointX(v), tri.get_PointY(v));
+    }
+    std::vector<index> faces;
+    faces.reserve(3 * face_to_global.size());
+    const auto owned_end = touched.begin() + static_cast<std::ptrdiff_t>(owned_vertices);
+    for(const auto f : face_to_global)
+    {
+        for(std::size_t j = 0; j < 3; ++j)
+        {
+            const auto v = tri.origin(3 * f + j);
+            // both groups are sorted, the owner of v tells which one to search
+            const auto it = partition.vertex_parts[v] == p ? std::ranges::lower_bound(touched.begin(), owned_end, v)
+                                                           : std::ranges::lower_bound(owned_end, touched.end(), v);
+            faces.push_back(static_cast<index>(it - touched.begin()));
+        }
+    }
+
+    mesh_part part{Triangulation(std::move(vertices), faces), owned.size(), owned_vertices};
+    part.vertex_to_global = std::move(touched);
+
+    const auto& mesh = part.mesh;
+    part.half_edge_to_global.assign(mesh.halfEdge_slots(), INVALID_INDEX);
+    part.is_cut.assign(mesh.halfEdge_slots(), 0);
+    for(index f = 0; f < face_to_global.size(); ++f)
+    {
+        for(std::size_t j = 0; j < 3; ++j)
+        {
+            part.half_edge_to_global[3 * f + j] = 3 * face_to_global[f] + j;
+        }
+    }
+    for(index e = 3 * face_to_global.size(); e < mesh.halfEdge_slots(); ++e)
+    {
+        if(!mesh.is_halfEdge_alive(e))
+        {
+            continue;
+        }
+        const auto global = tri.twin(part.half_edge_to_global[mesh.twin(e)]);
+        part.half_edge_to_global[e] = global;
+        part.is_cut[e] = tri.is_border_face(global) ? 0U : 1U;
+    }
+    part.face_to_global = std::move(face_to_global);
+    return part;
+}
+
+}
+
+mesh_partition partition_mesh(const Triangulation& tri, const partition_options& options)
+{
+    if(options.parts == 0)
+    {
+        throw std::invalid_argument("the number of parts must be positive");
+    }
+
+    // cut the curve in runs of equal length
+    const auto keys = sorted_face_keys(tri, options);
+    std::vector<index> face_parts(tri.face_slots(), INVALID_INDEX);
+    for(index k = 0; k < keys.size(); ++k)
+    {
+        face_parts[keys[k].second] = k * options.parts / keys.size();
+    }
+    refine_cuts(tri, options, face_parts);
+    return partition_mesh(tri, std::move(face_parts), options);
+}
+
+mesh_partition partition_mesh(const Triangulation& tri, std::vector<index> face_parts, const partition_options& options)
+{
+    if(options.parts == 0)
+    {
+        throw std::invalid_argument("the number of parts must be positive");
+    }
+    if(face_parts.size() != tri.face_slots())
+    {
+        throw std::invalid_argument("one part per face slot is expected");
+    }
+    for(index f = 0; f < face_parts.size(); ++f)
+    {
+        if(tri.is_face_alive(f) ? face_parts[f] >= options.parts : face_parts[f] != INVALID_INDEX)
+        {
+            throw std::invalid_argument("the faces must be in a part and the released faces in none");
+        }
+    }
+    mesh_partition partition;
+    partition.face_parts = std::move(face_parts);
+
+    std::vector<std::vector<index>> owned(options.parts);
+    std::vector<index> incidence_offsets(tri.vertex_slots() + 1, 0);
+    partition.vertex_parts.assign(tri.vertex_slots(), INVALID_INDEX);
+    for(index f = 0; f < partition.face_parts.size(); ++f)
+    {
+        const auto p = partition.face_parts[f];
+        if(p == INVALID_INDEX)
+        {
+            continue;
+        }
+        owned[p].push_back(f);
+        for(std::size_t j = 0; j < 3; ++j)
+        {
+            const auto v = tri.origin(3 * f + j);
+            ++incidence_offsets[v + 1];
+            partition.vertex_parts[v] = std::min(partition.vertex_parts[v], p);
+        }
+    }
+    for(index v = 0; v < tri.vertex_slots(); ++v)
+    {
+        incidence_offsets[v + 1] += incidence_offsets[v];
+    }
+    std::vector<index> incidence(incidence_offsets.back());
+    {
+        auto fill = incidence_offsets;
+        for(index f = 0; f < partition.face_parts.size(); ++f)
+        {
+            if(partition.face_parts[f] != INVALID_INDEX)
+            {
+                for(std::size_t j = 0; j < 3; ++j)
+                {
+                    incidence[fill[tri.origin(3 * f + j)]++] = f;
+                }
+            }
+        }
+    }
+
+    std::vector<std::optional<mesh_part>> parts(options.parts);
+    parallel_for(options.parts,
+                 options.threads,
+                 [&](std::size_t begin, std::size_t end)
+                 {
+                     for(auto p = begin; p < end; ++p)
+                     {
+                         parts[p].emplace(build_part(tri, partition, owned[p], incidence_offsets, incidence, p));
+                     }
+                 });
+
+    partition.vertex_owner_local.assign(tri.vertex_slots(), INVALID_INDEX);
+    partition.face_owner_local.assign(tri.face_slots(), INVALID_INDEX);
+    partition.parts.reserve(options.parts);
+    for(auto& part : parts)
+    {
+        for(index l = 0; l < part->owned_vertices; ++l)
+        {
+            partition.vertex_owner_local[part->vertex_to_global[l]] = l;
+        }
+        for(index l = 0; l < part->owned_faces; ++l)
+        {
+            partition.face_owner_local[part->face_to_global[l]] = l;
+        }
+        partition.parts.push_back(std::move(*part));
+    }
+    return partition;
+}
+
+}
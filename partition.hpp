@@ -0,0 +1,152 @@
+#pragma once
+
+#include "Triangulation.hpp"
+#include "parallel.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace half_edge {
+
+/// Space-filling curve ordering the face centroids before they are cut in parts
+enum class space_filling_curve
+{
+    morton,
+    hilbert
+};
+
+struct partition_options
+{
+    /// number of parts K, some parts are empty if there are fewer faces than parts
+    std::size_t parts{2};
+    space_filling_curve curve{space_filling_curve::hilbert};
+    /// number of greedy sweeps moving the faces of the cuts to the part holding most of their neighbours
+    std::size_t refinement_passes{0};
+    /// relative deviation from the ideal part size allowed during the refinement
+    double imbalance{0.05};
+    /// number of worker threads, 0 for the hardware concurrency
+    std::size_t threads{0};
+};
+
+/// One part of a partition: its owned faces plus the one-ring ghost layer, as a compact triangulation
+struct mesh_part
+{
+    /// owned faces come first, followed by the ghost faces sharing a vertex with an owned face and the ones filling
+    /// the gaps between the fans of a ghost vertex, which keep the part manifold; likewise for the vertices
+    Triangulation mesh;
+    std::size_t owned_faces{0};
+    std::size_t owned_vertices{0};
+    /// local to global index maps, local interior halfedge 3f + j is the global halfedge 3 face_to_global[f] + j
+    std::vector<index> vertex_to_global{};
+    std::vector<index> face_to_global{};
+    /// an exterior halfedge of the part maps to the global halfedge with the same origin and target
+    std::vector<index> half_edge_to_global{};
+    /// 1 for the exterior halfedges standing for a face of the global mesh that lies outside the part, i.e. the
+    /// twins cut by the ghost layer, 0 otherwise
+    std::vector<std::uint8_t> is_cut{};
+};
+
+struct mesh_partition
+{
+    std::vector<mesh_part> parts{};
+    /// owning part of each global face slot, INVALID_INDEX for the released faces
+    std::vector<index> face_parts{};
+    /// owning part of each global vertex slot, the smallest part among its faces; INVALID_INDEX if it has none
+    std::vector<index> vertex_parts{};
+    /// local index of each global vertex and face in its owning part
+    std::vector<index> vertex_owner_local{};
+    std::vector<index> face_owner_local{};
+};
+
+/**
+ * Splits the triangulation in balanced parts by cutting the faces sorted along a space-filling curve into
+ * contiguous runs, then optionally refines the cuts. The parts are built in parallel.
+ * @param[in] tri The triangulation
+ * @param[in] options The number of parts and the partitioning parameters
+ * @return the parts with their ghost layers and index maps
+ */
+[[nodiscard]] mesh_partition partition_mesh(const Triangulation& tri, const partition_options& options = {});
+
+/**
+ * Builds the parts of a given assignment of the faces, e.g. computed by an external partitioner, in parallel.
+ * @param[in] tri The triangulation
+ * @param[in] face_parts The part of each face slot, INVALID_INDEX for the released faces
+ * @param[in] options The number of parts and of threads, the curve and the refinement are not used
+ * @return the parts with their ghost layers and index maps
+ */
+[[nodiscard]] mesh_partition
+partition_mesh(const Triangulation& tri, std::vector<index> face_parts, const partition_options& options);
+
+namespace detail {
+
+template<class T>
+void exchange_halo(const std::vector<mesh_part>& parts,
+                   const std::vector<index>& owners,
+                   const std::vector<index>& owner_local,
+                   std::vector<std::vector<T>>& values,
+                   bool vertices,
+                   std::size_t threads)
+{
+    static_assert(!std::is_same_v<T, bool>, "std::vector<bool> cannot be written concurrently");
+    if(values.size() != parts.size())
+    {
+        throw std::invalid_argument("one vector of values per part is expected");
+    }
+    for(std::size_t p = 0; p < parts.size(); ++p)
+    {
+        const auto& to_global = vertices ? parts[p].vertex_to_global : parts[p].face_to_global;
+        if(values[p].size() != to_global.size())
+        {
+            throw std::invalid_argument("the number of values does not match the size of the part");
+        }
+    }
+    // the owned values are only read and the ghost values only written, so the parts are independent
+    parallel_for(parts.size(),
+                 threads,
+                 [&](std::size_t begin, std::size_t end)
+                 {
+                     for(auto p = begin; p < end; ++p)
+                     {
+                         const auto& part = parts[p];
+                         const auto& to_global = vertices ? part.vertex_to_global : part.face_to_global;
+                         const auto first_ghost = vertices ? part.owned_vertices : part.owned_faces;
+                         for(auto l = first_ghost; l < to_global.size(); ++l)
+                         {
+                             const auto g = to_global[l];
+                             values[p][l] = values[owners[g]][owner_local[g]];
+                         }
+                     }
+                 });
+}
+
+}
+
+/**
+ * Copies the values of the owned vertices to their ghost copies in the other parts.
+ * @param[in] partition The partition
+ * @param[in,out] values One value per local vertex for every part
+ * @param[in] threads The number of worker threads, 0 for the hardware concurrency
+ */
+template<class T>
+void exchange_vertex_halo(const mesh_partition& partition, std::vector<std::vector<T>>& values, std::size_t threads = 0)
+{
+    detail::exchange_halo(
+        partition.parts, partition.vertex_parts, partition.vertex_owner_local, values, true, threads);
+}
+
+/**
+ * Copies the values of the owned faces to their ghost copies in the other parts.
+ * @param[in] partition The partition
+ * @param[in,out] values One value per local face for every part
+ * @param[in] threads The number of worker threads, 0 for the hardware concurrency
+ */
+template<class T>
+void exchange_face_halo(const mesh_partition& partition, std::vector<std::vector<T>>& values, std::size_t threads = 0)
+{
+    detail::exchange_halo(partition.parts, partition.face_parts, partition.face_owner_local, values, false, threads);
+}
+
+}
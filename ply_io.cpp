@@ -0,0 +1,866 @@
+#include "ply_io.hpp"
+#include "model_io.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HE_PLY_MMAP 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace half_edge {
+
+namespace {
+
+// read-only view of a whole file, memory mapped where the platform allows it and read in a buffer otherwise
+class file_view
+{
+  public:
+    explicit file_view(const std::string& name);
+    file_view(const file_view&) = delete;
+    file_view& operator=(const file_view&) = delete;
+    ~file_view();
+
+    [[nodiscard]] std::string_view bytes() const { return {m_data, m_size}; }
+
+  private:
+    const char* m_data{nullptr};
+    std::size_t m_size{0};
+#if !defined(HE_PLY_MMAP)
+    std::vector<char> m_buffer{};
+#endif
+};
+
+#if defined(HE_PLY_MMAP)
+file_view::file_view(const std::string& name)
+{
+    const int fd = ::open(name.c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "unable to open file " + name);
+    }
+    struct stat status{};
+    if(::fstat(fd, &status) != 0)
+    {
+        const auto error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "fstat");
+    }
+    m_size = static_cast<std::size_t>(status.st_size);
+    if(m_size == 0)
+    {
+        ::close(fd);
+        return;
+    }
+    auto* address = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    const auto error = errno;
+    ::close(fd);
+    if(address == MAP_FAILED)
+    {
+        throw std::system_error(error, std::generic_category(), "mmap");
+    }
+    ::posix_madvise(address, m_size, POSIX_MADV_SEQUENTIAL);
+    m_data = static_cast<const char*>(address);
+}
+
+file_view::~file_view()
+{
+    if(m_data != nullptr)
+    {
+        ::munmap(const_cast<char*>(m_data), m_size);
+    }
+}
+#else
+file_view::file_view(const std::string& name)
+{
+    std::ifstream file(name, std::ios::binary | std::ios::ate);
+    if(!file.is_open())
+    {
+        throw std::runtime_error("unable to open file " + name);
+    }
+    m_buffer.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+}
+
+file_view::~file_view() = default;
+#endif
+
+std::vector<std::string_view> split_words(std::string_view line)
+{
+    std::vector<std::string_view> words;
+    std::size_t position = 0;
+    while(position < line.size())
+    {
+        if(is_space_char(line[position]))
+        {
+            ++position;
+            continue;
+        }
+        auto end = position;
+        while(end < line.size() && !is_space_char(line[end]))
+        {
+            ++end;
+        }
+        words.push_back(line.substr(position, end - position));
+        position = end;
+    }
+    return words;
+}
+
+ply_type parse_type(std::string_view name)
+{
+    static constexpr std::pair<std::string_view, ply_type> names[] = {
+        {"char", ply_type::int8},       {"int8", ply_type::int8},       {"uchar", ply_type::uint8},
+        {"uint8", ply_type::uint8},     {"short", ply_type::int16},     {"int16", ply_type::int16},
+        {"ushort", ply_type::uint16},   {"uint16", ply_type::uint16},   {"int", ply_type::int32},
+        {"int32", ply_type::int32},     {"uint", ply_type::uint32},     {"uint32", ply_type::uint32},
+        {"float", ply_type::float32},   {"float32", ply_type::float32}, {"double", ply_type::float64},
+        {"float64", ply_type::float64}};
+    const auto* found = std::ranges::find(names, name, &std::pair<std::string_view, ply_type>::first);
+    if(found == std::end(names))
+    {
+        throw std::invalid_argument("unknown PLY property type: " + std::string(name));
+    }
+    return found->second;
+}
+
+constexpr std::size_t type_size(ply_type type)
+{
+    switch(type)
+    {
+        case ply_type::int8:
+        case ply_type::uint8: return 1;
+        case ply_type::int16:
+        case ply_type::uint16: return 2;
+        case ply_type::int32:
+        case ply_type::uint32:
+        case ply_type::float32: return 4;
+        case ply_type::float64: return 8;
+    }
+    std::unreachable();
+}
+
+constexpr bool is_integer(ply_type type) { return type != ply_type::float32 && type != ply_type::float64; }
+
+// calls f with a value of the C++ type of a PLY type
+template<class F>
+decltype(auto) visit_type(ply_type type, F&& f)
+{
+    switch(type)
+    {
+        case ply_type::int8: return f(std::int8_t{});
+        case ply_type::uint8: return f(std::uint8_t{});
+        case ply_type::int16: return f(std::int16_t{});
+        case ply_type::uint16: return f(std::uint16_t{});
+        case ply_type::int32: return f(std::int32_t{});
+        case ply_type::uint32: return f(std::uint32_t{});
+        case ply_type::float32: return f(float{});
+        case ply_type::float64: return f(double{});
+    }
+    std::unreachable();
+}
+
+// loads an unaligned value, swapping its bytes when the file and host byte orders differ
+template<class T>
+T load(const char* p, bool swap)
+{
+    using wide = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+    using bits = std::conditional_t<sizeof(T) == 1,
+                                    std::uint8_t,
+                                    std::conditional_t<sizeof(T) == 2, std::uint16_t, wide>>;
+    bits raw;
+    std::memcpy(&raw, p, sizeof(raw));
+    if(swap)
+    {
+        raw = std::byteswap(raw);
+    }
+    return std::bit_cast<T>(raw);
+}
+
+// loads an integer that must not be negative, does not throw so that the parallel copies can use it
+template<class T>
+bool load_unsigned(const char* p, bool swap, std::size_t& value)
+{
+    const auto raw = load<T>(p, swap);
+    if constexpr(std::is_signed_v<T>)
+    {
+        if(raw < 0)
+        {
+            return false;
+        }
+    }
+    value = static_cast<std::size_t>(raw);
+    return true;
+}
+
+bool load_unsigned(const char* p, ply_type type, bool swap, std::size_t& value)
+{
+    return visit_type(type,
+                      [&]<class T>(T)
+                      {
+                          if constexpr(std::is_integral_v<T>)
+                          {
+                              return load_unsigned<T>(p, swap, value);
+                          }
+                          else
+                          {
+                              return false;
+                          }
+                      });
+}
+
+std::size_t property_position(const ply_element& element, std::string_view name)
+{
+    const auto found = std::ranges::find(element.properties, name, &ply_property::name);
+    return static_cast<std::size_t>(std::ranges::distance(element.properties.begin(), found));
+}
+
+// positions of the x and y scalar properties of the vertex element
+std::pair<std::size_t, std::size_t> vertex_columns(const ply_element& element)
+{
+    const auto x = property_position(element, "x");
+    const auto y = property_position(element, "y");
+    if(x == element.properties.size() || y == element.properties.size() || element.properties[x].is_list ||
+       element.properties[y].is_list)
+    {
+        throw std::invalid_argument("the PLY vertex element has no x and y properties");
+    }
+    return {x, y};
+}
+
+// position of the vertex index list of the face element
+std::size_t face_column(const ply_element& element)
+{
+    auto list = property_position(element, "vertex_indices");
+    if(list == element.properties.size())
+    {
+        list = property_position(element, "vertex_index");
+    }
+    if(list == element.properties.size() || !element.properties[list].is_list)
+    {
+        throw std::invalid_argument("the PLY face element has no vertex_indices list");
+    }
+    if(!is_integer(element.properties[list].type) || !is_integer(element.properties[list].count_type))
+    {
+        throw std::invalid_argument("the PLY vertex indices must be integers");
+    }
+    return list;
+}
+
+constexpr auto TRUNCATED_BODY = "the PLY body is truncated";
+constexpr auto NOT_TRIANGLES = "only triangular faces are supported";
+constexpr auto INVALID_COUNT = "invalid PLY list size";
+
+struct binary_body
+{
+    const char* data;
+    std::size_t size;
+    bool swap;
+
+    void require(std::size_t offset, std::size_t bytes) const
+    {
+        if(offset > size || bytes > size - offset)
+        {
+            throw std::invalid_argument(TRUNCATED_BODY);
+        }
+    }
+};
+
+// size of the records of an element without list properties, 0 otherwise
+std::size_t fixed_record_size(const ply_element& element)
+{
+    std::size_t size = 0;
+    for(const auto& property : element.properties)
+    {
+        if(property.is_list)
+        {
+            return 0;
+        }
+        size += type_size(property.type);
+    }
+    return size;
+}
+
+// lower bound of the size of a record: the item count of a list in a binary body, a token per property in an ASCII one
+std::size_t min_record_size(const ply_element& element, ply_format format)
+{
+    std::size_t size = 0;
+    for(const auto& property : element.properties)
+    {
+        size += format == ply_format::ascii ? 1 : type_size(property.is_list ? property.count_type : property.type);
+    }
+    return std::max<std::size_t>(size, 1);
+}
+
+// rejects the element counts that cannot fit in the body, before anything is allocated from them
+void check_counts(const ply_header& header, std::size_t body_size)
+{
+    for(const auto& element : header.elements)
+    {
+        const auto record = min_record_size(element, header.format);
+        if(element.count > body_size / record)
+        {
+            throw std::invalid_argument(TRUNCATED_BODY);
+        }
+        body_size -= element.count * record;
+    }
+}
+
+// walks the record at offset, stores the offset of each property and returns the record size
+std::size_t record_layout(const ply_element& element,
+                          const binary_body& body,
+                          std::size_t offset,
+                          std::vector<std::size_t>& property_offsets)
+{
+    property_offsets.clear();
+    std::size_t size = 0;
+    for(const auto& property : element.properties)
+    {
+        property_offsets.push_back(offset + size);
+        if(!property.is_list)
+        {
+            size += type_size(property.type);
+            continue;
+        }
+        body.require(offset + size, type_size(property.count_type));
+        std::size_t count = 0;
+        if(!load_unsigned(body.data + offset + size, property.count_type, body.swap, count))
+        {
+            throw std::invalid_argument(INVALID_COUNT);
+        }
+        size += type_size(property.count_type) + count * type_size(property.type);
+    }
+    body.require(offset, size);
+    return size;
+}
+
+std::size_t skip_binary_element(const ply_element& element, const binary_body& body, std::size_t offset)
+{
+    if(const auto stride = fixed_record_size(element); stride != 0)
+    {
+        if(element.count > (body.size - std::min(offset, body.size)) / stride)
+        {
+            throw std::invalid_argument(TRUNCATED_BODY);
+        }
+        return offset + element.count * stride;
+    }
+    std::vector<std::size_t> property_offsets;
+    for(std::size_t k = 0; k < element.count; ++k)
+    {
+        offset += record_layout(element, body, offset, property_offsets);
+    }
+    return offset;
+}
+
+// copies the x and y columns of fixed size records
+template<class X, class Y>
+void copy_columns(const char* records,
+                  std::size_t stride,
+                  std::size_t x_offset,
+                  std::size_t y_offset,
+                  bool swap,
+                  std::span<vertex> vertices,
+                  std::size_t threads)
+{
+    parallel_for(vertices.size(),
+                 threads,
+                 [&](std::size_t begin, std::size_t end)
+                 {
+                     for(auto k = begin; k < end; ++k)
+                     {
+                         const char* record = records + k * stride;
+                         vertices[k].x = static_cast<double>(load<X>(record + x_offset, swap));
+                         vertices[k].y = static_cast<double>(load<Y>(record + y_offset, swap));
+                     }
+                 });
+}
+
+enum class copy_status : std::uint8_t
+{
+    done,
+    not_triangle,
+    negative
+};
+
+// copies the index lists of fixed size triangle records, records points to the item count of the first one
+template<class C, class I>
+copy_status
+copy_triangles(const char* records, std::size_t stride, bool swap, std::span<index> faces, std::size_t threads)
+{
+    // a record that is not a triangle is met at its exact place since all the previous ones are triangles
+    std::atomic<copy_status> status{copy_status::done};
+    parallel_for(faces.size() / 3,
+                 threads,
+                 [&](std::size_t begin, std::size_t end)
+                 {
+                     for(auto k = begin; k < end; ++k)
+                     {
+                         const char* record = records + k * stride;
+                         std::size_t count = 0;
+                         if(!load_unsigned<C>(record, swap, count) || count != 3)
+                         {
+                             status.store(copy_status::not_triangle, std::memory_order_relaxed);
+                             return;
+                         }
+                         for(std::size_t c = 0; c < 3; ++c)
+                         {
+                             if(!load_unsigned<I>(record + sizeof(C) + c * sizeof(I), swap, faces[3 * k + c]))
+                             {
+                                 auto expected = copy_status::done;
+                                 status.compare_exchange_strong(expected, copy_status::negative);
+                             }
+                         }
+                     }
+                 });
+    return status.load();
+}
+
+std::size_t read_binary_vertices(const ply_element& element,
+                                 const binary_body& body,
+                                 std::size_t offset,
+                                 std::span<vertex> vertices,
+                                 std::size_t threads)
+{
+    const auto [x, y] = vertex_columns(element);
+    const auto x_type = element.properties[x].type;
+    const auto y_type = element.properties[y].type;
+    const auto stride = fixed_record_size(element);
+    if(stride == 0)
+    {
+        std::vector<std::size_t> property_offsets;
+        for(auto& v : vertices)
+        {
+            const auto size = record_layout(element, body, offset, property_offsets);
+            const char* x_value = body.data + property_offsets[x];
+            const char* y_value = body.data + property_offsets[y];
+            v.x = visit_type(x_type, [&]<class T>(T) { return static_cast<double>(load<T>(x_value, body.swap)); });
+            v.y = visit_type(y_type, [&]<class T>(T) { return static_cast<double>(load<T>(y_value, body.swap)); });
+            offset += size;
+        }
+        return offset;
+    }
+
+    if(vertices.size() > (body.size - std::min(offset, body.size)) / stride)
+    {
+        throw std::invalid_argument(TRUNCATED_BODY);
+    }
+    std::size_t x_offset = 0;
+    std::size_t y_offset = 0;
+    for(std::size_t k = 0, position = 0; k < element.properties.size(); ++k)
+    {
+        x_offset = k == x ? position : x_offset;
+        y_offset = k == y ? position : y_offset;
+        position += type_size(element.properties[k].type);
+    }
+    const char* records = body.data + offset;
+    visit_type(x_type,
+               [&]<class X>(X)
+               {
+                   visit_type(
+                       y_type,
+                       [&]<class Y>(Y)
+                       { copy_columns<X, Y>(records, stride, x_offset, y_offset, body.swap, vertices, threads); });
+               });
+    return offset + vertices.size() * stride;
+}
+
+std::size_t read_binary_faces(const ply_element& element,
+                              const binary_body& body,
+                              std::size_t offset,
+                              std::span<index> faces,
+                              std::size_t threads)
+{
+    const auto list = face_column(element);
+    const auto& indices = element.properties[list];
+    const auto count_size = type_size(indices.count_type);
+    const auto index_size = type_size(indices.type);
+
+    // with a single list, a mesh of triangles has records of a fixed size
+    const auto n_lists = std::ranges::count_if(element.properties, &ply_property::is_list);
+    std::size_t before = 0;
+    std::size_t after = 0;
+    for(std::size_t k = 0; k < element.properties.size(); ++k)
+    {
+        if(k != list)
+        {
+            (k < list ? before : after) += element.properties[k].is_list ? 0 : type_size(element.properties[k].type);
+        }
+    }
+    const auto stride = before + count_size + 3 * index_size + after;
+    const auto n_faces = faces.size() / 3;
+    if(n_lists == 1 && n_faces <= (body.size - std::min(offset, body.size)) / stride)
+    {
+        const char* records = body.data + offset + before;
+        const auto status = visit_type(
+            indices.count_type,
+            [&]<class C>(C)
+            {
+                return visit_type(indices.type,
+                                  [&]<class I>(I)
+                                  {
+                                      if constexpr(std::is_integral_v<C> && std::is_integral_v<I>)
+                                      {
+                                          return copy_triangles<C, I>(records, stride, body.swap, faces, threads);
+                                      }
+                                      else
+                                      {
+                                          return copy_status::not_triangle;
+                                      }
+                                  });
+            });
+        if(status == copy_status::not_triangle)
+        {
+            throw std::invalid_argument(NOT_TRIANGLES);
+        }
+        if(status == copy_status::negative)
+        {
+            throw std::invalid_argument("face indices must be non-negative");
+        }
+        return offset + n_faces * stride;
+    }
+
+    std::vector<std::size_t> property_offsets;
+    for(std::size_t k = 0; k < n_faces; ++k)
+    {
+        const auto size = record_layout(element, body, offset, property_offsets);
+        const char* record = body.data + property_offsets[list];
+        std::size_t count = 0;
+        if(!load_unsigned(record, indices.count_type, body.swap, count) || count != 3)
+        {
+            throw std::invalid_argument(NOT_TRIANGLES);
+        }
+        for(std::size_t c = 0; c < 3; ++c)
+        {
+            if(!load_unsigned(record + count_size + c * index_size, indices.type, body.swap, faces[3 * k + c]))
+            {
+                throw std::invalid_argument("face indices must be non-negative");
+            }
+        }
+        offset += size;
+    }
+    return offset;
+}
+
+// whitespace separated tokens of an ASCII body
+class ascii_scanner
+{
+  public:
+    ascii_scanner(std::string_view text, std::size_t position)
+        : m_text(text), m_position(position) {}
+
+    std::string_view next()
+    {
+        while(m_position < m_text.size() && is_space_char(m_text[m_position]))
+        {
+            ++m_position;
+        }
+        if(m_position == m_text.size())
+        {
+            throw std::invalid_argument(TRUNCATED_BODY);
+        }
+        const auto begin = m_position;
+        while(m_position < m_text.size() && !is_space_char(m_text[m_position]))
+        {
+            ++m_position;
+        }
+        return m_text.substr(begin, m_position - begin);
+    }
+
+    double next_double()
+    {
+        const auto token = next();
+        auto rest = token;
+        double value{0.};
+        if(!parse_next(rest, value) || !rest.empty())
+        {
+            throw std::invalid_argument("failed to parse the PLY value: " + std::string(token));
+        }
+        return value;
+    }
+
+    std::size_t next_unsigned()
+    {
+        const auto token = next();
+        std::size_t value{0};
+        const auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), value);
+        if(error != std::errc{} || end != token.data() + token.size())
+        {
+            throw std::invalid_argument("failed to parse the PLY index: " + std::string(token));
+        }
+        return value;
+    }
+
+    void skip(const ply_property& property)
+    {
+        const auto n = property.is_list ? next_unsigned() : 0;
+        if(!property.is_list)
+        {
+            next();
+        }
+        for(std::size_t k = 0; k < n; ++k)
+        {
+            next();
+        }
+    }
+
+  private:
+    std::string_view m_text;
+    std::size_t m_position;
+};
+
+void read_ascii_vertices(const ply_element& element, ascii_scanner& scanner, std::span<vertex> vertices)
+{
+    const auto [x, y] = vertex_columns(element);
+    for(auto& v : vertices)
+    {
+        for(std::size_t k = 0; k < element.properties.size(); ++k)
+        {
+            if(k == x)
+            {
+                v.x = scanner.next_double();
+            }
+            else if(k == y)
+            {
+                v.y = scanner.next_double();
+            }
+            else
+            {
+                scanner.skip(element.properties[k]);
+            }
+        }
+    }
+}
+
+void read_ascii_faces(const ply_element& element, ascii_scanner& scanner, std::span<index> faces)
+{
+    const auto list = face_column(element);
+    for(std::size_t f = 0; f < faces.size() / 3; ++f)
+    {
+        for(std::size_t k = 0; k < element.properties.size(); ++k)
+        {
+            if(k != list)
+            {
+                scanner.skip(element.properties[k]);
+                continue;
+            }
+            if(scanner.next_unsigned() != 3)
+            {
+                throw std::invalid_argument(NOT_TRIANGLES);
+            }
+            for(std::size_t c = 0; c < 3; ++c)
+            {
+                faces[3 * f + c] = scanner.next_unsigned();
+            }
+        }
+    }
+}
+
+}
+
+[[nodiscard]]
+ply_header parse_ply_header(std::string_view text)
+{
+    ply_header header;
+    bool has_magic = false;
+    bool has_format = false;
+    std::size_t position = 0;
+    while(position < text.size())
+    {
+        const auto end = text.find('\n', position);
+        if(end == std::string_view::npos)
+        {
+            break;
+        }
+        const auto words = split_words(text.substr(position, end - position));
+        position = end + 1;
+        if(!has_magic)
+        {
+            if(words.size() != 1 || words[0] != PLY_HEADER)
+            {
+                throw std::invalid_argument("the file is not a PLY file");
+            }
+            has_magic = true;
+            continue;
+        }
+        if(words.empty() || words[0] == "comment" || words[0] == "obj_info")
+        {
+            continue;
+        }
+        if(words[0] == "format" && words.size() == 3)
+        {
+            if(words[1] == "ascii")
+            {
+                header.format = ply_format::ascii;
+            }
+            else if(words[1] == "binary_little_endian")
+            {
+                header.format = ply_format::binary_little_endian;
+            }
+            else if(words[1] == "binary_big_endian")
+            {
+                header.format = ply_format::binary_big_endian;
+            }
+            else
+            {
+                throw std::invalid_argument("unknown PLY format: " + std::string(words[1]));
+            }
+            has_format = true;
+        }
+        else if(words[0] == "element" && words.size() == 3)
+        {
+            ply_element element{.name = std::string(words[1])};
+            const auto [count_end, error] =
+                std::from_chars(words[2].data(), words[2].data() + words[2].size(), element.count);
+            if(error != std::errc{} || count_end != words[2].data() + words[2].size())
+            {
+                throw std::invalid_argument("invalid PLY element count: " + std::string(words[2]));
+            }
+            header.elements.push_back(std::move(element));
+        }
+        else if(words[0] == "property" && !header.elements.empty() && (words.size() == 3 || words.size() == 5))
+        {
+            ply_property property;
+            if(words.size() == 5 && words[1] == "list")
+            {
+                property.is_list = true;
+                property.count_type = parse_type(words[2]);
+                if(!is_integer(property.count_type))
+                {
+                    throw std::invalid_argument(INVALID_COUNT);
+                }
+                property.type = parse_type(words[3]);
+            }
+            else if(words.size() == 3)
+            {
+                property.type = parse_type(words[1]);
+            }
+            else
+            {
+                throw std::invalid_argument("invalid PLY property line");
+            }
+            property.name = std::string(words.back());
+            header.elements.back().properties.push_back(std::move(property));
+        }
+        else if(words[0] == "end_header" && words.size() == 1)
+        {
+            if(!has_format)
+            {
+                throw std::invalid_argument("the PLY header has no format line");
+            }
+            header.body_offset = position;
+            return header;
+        }
+        else
+        {
+            throw std::invalid_argument("invalid PLY header line: " + std::string(words[0]));
+        }
+    }
+    throw std::invalid_argument("the PLY header is not terminated");
+}
+
+[[nodiscard]]
+bool is_ply_file(const std::string& name)
+{
+    std::ifstream file(name, std::ios::binary);
+    std::string line;
+    if(!std::getline(file, line))
+    {
+        return false;
+    }
+    if(line.ends_with('\r'))
+    {
+        line.pop_back();
+    }
+    return line == PLY_HEADER;
+}
+
+template<class VertexAllocator, class IndexAllocator>
+void read_PLYfile(const std::string& name,
+                  std::vector<vertex, VertexAllocator>& vertices,
+                  std::vector<index, IndexAllocator>& faces,
+                  std::size_t threads)
+{
+    const file_view file(name);
+    const auto bytes = file.bytes();
+    const auto header = parse_ply_header(bytes);
+    const auto vertex_element = std::ranges::find(header.elements, "vertex", &ply_element::name);
+    const auto face_element = std::ranges::find(header.elements, "face", &ply_element::name);
+    if(vertex_element == header.elements.end() || face_element == header.elements.end())
+    {
+        throw std::invalid_argument("the PLY file has no vertex or no face element");
+    }
+    if(face_element->count > faces.max_size() / 3)
+    {
+        throw std::invalid_argument("invalid PLY element count: " + std::to_string(face_element->count));
+    }
+    check_counts(header, bytes.size() - header.body_offset);
+    vertices.assign(vertex_element->count, vertex{});
+    faces.assign(3 * face_element->count, index{0});
+
+    // a repeated vertex or face element is skipped
+    if(header.format == ply_format::ascii)
+    {
+        ascii_scanner scanner(bytes, header.body_offset);
+        for(auto element = header.elements.begin(); element != header.elements.end(); ++element)
+        {
+            if(element == vertex_element)
+            {
+                read_ascii_vertices(*element, scanner, vertices);
+            }
+            else if(element == face_element)
+            {
+                read_ascii_faces(*element, scanner, faces);
+            }
+            else
+            {
+                for(std::size_t k = 0; k < element->count; ++k)
+                {
+                    std::ranges::for_each(element->properties, [&scanner](const ply_property& p) { scanner.skip(p); });
+                }
+            }
+        }
+        return;
+    }
+
+    const auto little = header.format == ply_format::binary_little_endian;
+    const binary_body body{bytes.data(), bytes.size(), little != (std::endian::native == std::endian::little)};
+    auto offset = header.body_offset;
+    for(auto element = header.elements.begin(); element != header.elements.end(); ++element)
+    {
+        if(element == vertex_element)
+        {
+            offset = read_binary_vertices(*element, body, offset, vertices, threads);
+        }
+        else if(element == face_element)
+        {
+            offset = read_binary_faces(*element, body, offset, faces, threads);
+        }
+        else
+        {
+            offset = skip_binary_element(*element, body, offset);
+        }
+    }
+}
+
+template void read_PLYfile(const std::string&, std::vector<vertex>&, std::vector<index>&, std::size_t);
+template void read_PLYfile(const std::string&, std::pmr::vector<vertex>&, std::pmr::vector<index>&, std::size_t);
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Triangulation.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace half_edge {
+constexpr auto PLY_HEADER{"ply"};
+
+enum class ply_format : std::uint8_t
+{
+    ascii,
+    binary_little_endian,
+    binary_big_endian
+};
+
+enum class ply_type : std::uint8_t
+{
+    int8,
+    uint8,
+    int16,
+    uint16,
+    int32,
+    uint32,
+    float32,
+    float64
+};
+
+struct ply_property
+{
+    std::string name{};
+    /// type of the value, or of the list items
+    ply_type type{ply_type::float32};
+    bool is_list{false};
+    /// type of the item count of a list
+    ply_type count_type{ply_type::uint8};
+};
+
+struct ply_element
+{
+    std::string name{};
+    std::size_t count{0};
+    std::vector<ply_property> properties{};
+};
+
+struct ply_header
+{
+    ply_format format{ply_format::ascii};
+    std::vector<ply_element> elements{};
+    /// offset of the first byte after the end_header line
+    std::size_t body_offset{0};
+};
+
+/**
+ * Parses the header of a PLY file, from the "ply" line to the "end_header" line.
+ * @param[in] text The beginning of the file, at least up to the end of the header
+ * @return the format and the layout of the elements
+ */
+[[nodiscard]]
+ply_header parse_ply_header(std::string_view text);
+
+/**
+ * Checks if the file starts with the PLY magic line.
+ * @param[in] name The path of the file
+ * @return true if the file can be opened and is a PLY file, false otherwise
+ */
+[[nodiscard]]
+bool is_ply_file(const std::string& name);
+
+/**
+ * Reads the triangles of an ASCII or binary PLY file. The file is memory mapped when the platform allows it. The x
+ * and y columns of the vertex element and the vertex_indices lists of the face element are copied directly from the
+ * binary body, in parallel when the records have a fixed size; an ASCII body is scanned with from_chars.
+ * Instantiated for the standard and the polymorphic allocators.
+ * @param[in] name The path of the file
+ * @param[out] vertices The vertices
+ * @param[out] faces The flatten vector of triangle vertex indices
+ * @param[in] threads The number of threads of the binary copies, 0 for the hardware concurrency
+ */
+template<class VertexAllocator, class IndexAllocator>
+void read_PLYfile(const std::string& name,
+                  std::vector<vertex, VertexAllocator>& vertices,
+                  std::vector<index, IndexAllocator>& faces,
+                  std::size_t threads = 0);
+
+}
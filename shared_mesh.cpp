@@ -0,0 +1,272 @@
+#include "shared_mesh.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace half_edge {
+
+namespace {
+
+constexpr std::uint64_t SHARED_MAGIC = 0x4845'4d45'5348'0001ULL;
+constexpr std::size_t HALF_EDGE_ALIGNMENT = 64;
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "the use count must be address free");
+
+struct shared_header
+{
+    std::uint64_t magic{};
+    std::uint64_t vertex_size{};
+    std::uint64_t half_edge_size{};
+    std::uint64_t n_vertices{};
+    std::uint64_t n_half_edges{};
+    std::uint64_t n_faces{};
+    std::uint64_t vertex_slots{};
+    std::uint64_t half_edge_slots{};
+    /// offset of the halfedge array from the start of the segment
+    std::uint64_t half_edge_offset{};
+    std::uint64_t size{};
+    /// 0 while the segment is filled or after the last user left, attaching is refused then
+    std::atomic<std::uint32_t> users{0};
+};
+
+static_assert(sizeof(shared_header) <= shared_triangulation::SHARED_VERTEX_OFFSET);
+
+std::string segment_name(const std::string& name)
+{
+    auto result = name.starts_with('/') ? name : "/" + name;
+    if(result.size() < 2 || result.find('/', 1) != std::string::npos)
+    {
+        throw std::invalid_argument("invalid shared memory name: " + name);
+    }
+    return result;
+}
+
+[[noreturn]] void throw_errno(const std::string& what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// closes the descriptor when leaving the scope, the mappings outlive it
+struct fd_guard
+{
+    int fd;
+    ~fd_guard() { ::close(fd); }
+};
+
+void* map(std::size_t size, int protection, int fd, std::size_t offset)
+{
+    if(size == 0)
+    {
+        return nullptr;
+    }
+    auto* address = ::mmap(nullptr, size, protection, MAP_SHARED, fd, static_cast<off_t>(offset));
+    if(address == MAP_FAILED)
+    {
+        throw_errno("mmap");
+    }
+    return address;
+}
+
+}
+
+shared_triangulation shared_triangulation::publish(const Triangulation& tri, const std::string& name)
+{
+    const auto vertices = tri.vertex_storage();
+    const auto half_edges = tri.halfEdge_storage();
+    const auto vertex_bytes = vertices.size_bytes();
+    const auto half_edge_offset =
+        (SHARED_VERTEX_OFFSET + vertex_bytes + HALF_EDGE_ALIGNMENT - 1) / HALF_EDGE_ALIGNMENT * HALF_EDGE_ALIGNMENT;
+    const auto size = half_edge_offset + half_edges.size_bytes();
+
+    shared_triangulation shared;
+    shared.m_name = segment_name(name);
+    const fd_guard guard{::shm_open(shared.m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600)};
+    if(guard.fd < 0)
+    {
+        throw_errno("shm_open " + shared.m_name);
+    }
+    if(::ftruncate(guard.fd, static_cast<off_t>(size)) != 0)
+    {
+        const auto error = errno;
+        ::shm_unlink(shared.m_name.c_str());
+        throw std::system_error(error, std::generic_category(), "ftruncate " + shared.m_name);
+    }
+    try
+    {
+        shared.m_header = map(SHARED_VERTEX_OFFSET, PROT_READ | PROT_WRITE, guard.fd, 0);
+        shared.m_data_size = size - SHARED_VERTEX_OFFSET;
+        shared.m_data = map(shared.m_data_size, PROT_READ | PROT_WRITE, guard.fd, SHARED_VERTEX_OFFSET);
+    }
+    catch(...)
+    {
+        ::shm_unlink(shared.m_name.c_str());
+        throw;
+    }
+
+    auto* data = static_cast<char*>(shared.m_data);
+    if(!vertices.empty())
+    {
+        std::memcpy(data, vertices.data(), vertex_bytes);
+    }
+    if(!half_edges.empty())
+    {
+        std::memcpy(data + (half_edge_offset - SHARED_VERTEX_OFFSET), half_edges.data(), half_edges.size_bytes());
+    }
+    if(shared.m_data != nullptr && ::mprotect(shared.m_data, shared.m_data_size, PROT_READ) != 0)
+    {
+        // the handle is not attached yet, its destructor only unmaps
+        const auto error = errno;
+        ::shm_unlink(shared.m_name.c_str());
+        throw std::system_error(error, std::generic_category(), "mprotect " + shared.m_name);
+    }
+
+    auto* header = new(shared.m_header) shared_header{};
+    header->magic = SHARED_MAGIC;
+    header->vertex_size = sizeof(vertex);
+    header->half_edge_size = sizeof(half_edge);
+    header->n_vertices = tri.vertices_size();
+    header->n_half_edges = tri.halfEdges_size();
+    header->n_faces = tri.faces_size();
+    header->vertex_slots = vertices.size();
+    header->half_edge_slots = half_edges.size();
+    header->half_edge_offset = half_edge_offset;
+    header->size = size;
+    // the segment becomes visible to attach() once filled
+    header->users.store(1, std::memory_order_release);
+    shared.m_attached = true;
+
+    shared.m_view = triangulation_view(
+        {reinterpret_cast<const vertex*>(data), vertices.size()},
+        {reinterpret_cast<const half_edge*>(data + (half_edge_offset - SHARED_VERTEX_OFFSET)), half_edges.size()},
+        tri.vertices_size(),
+        tri.halfEdges_size(),
+        tri.faces_size());
+    return shared;
+}
+
+shared_triangulation shared_triangulation::attach(const std::string& name)
+{
+    shared_triangulation shared;
+    shared.m_name = segment_name(name);
+    const fd_guard guard{::shm_open(shared.m_name.c_str(), O_RDWR, 0)};
+    if(guard.fd < 0)
+    {
+        throw_errno("shm_open " + shared.m_name);
+    }
+    struct stat status
+    {
+    };
+    if(::fstat(guard.fd, &status) != 0)
+    {
+        throw_errno("fstat " + shared.m_name);
+    }
+    if(static_cast<std::size_t>(status.st_size) < SHARED_VERTEX_OFFSET)
+    {
+        throw std::runtime_error("shared memory segment not ready: " + shared.m_name);
+    }
+    auto* header = static_cast<shared_header*>(map(SHARED_VERTEX_OFFSET, PROT_READ | PROT_WRITE, guard.fd, 0));
+    // the handle unmaps the header but gives no reference back until it is attached
+    shared.m_header = header;
+    auto users = header->users.load(std::memory_order_acquire);
+    if(users == 0)
+    {
+        throw std::runtime_error("shared memory segment not ready or released: " + shared.m_name);
+    }
+    // the fields are filled before the use count is first published, a segment of another layout is left untouched
+    if(header->magic != SHARED_MAGIC || header->vertex_size != sizeof(vertex) ||
+       header->half_edge_size != sizeof(half_edge) || header->size != static_cast<std::uint64_t>(status.st_size))
+    {
+        throw std::runtime_error("incompatible shared memory segment: " + shared.m_name);
+    }
+    do
+    {
+        if(users == 0)
+        {
+            throw std::runtime_error("shared memory segment not ready or released: " + shared.m_name);
+        }
+    } while(!header->users.compare_exchange_weak(users, users + 1, std::memory_order_acq_rel));
+    shared.m_attached = true;
+    shared.m_data_size = header->size - SHARED_VERTEX_OFFSET;
+    shared.m_data = map(shared.m_data_size, PROT_READ, guard.fd, SHARED_VERTEX_OFFSET);
+
+    const auto* data = static_cast<const char*>(shared.m_data);
+    shared.m_view = triangulation_view(
+        {reinterpret_cast<const vertex*>(data), header->vertex_slots},
+        {reinterpret_cast<const half_edge*>(data + (header->half_edge_offset - SHARED_VERTEX_OFFSET)),
+         header->half_edge_slots},
+        header->n_vertices,
+        header->n_half_edges,
+        header->n_faces);
+    return shared;
+}
+
+void shared_triangulation::remove(const std::string& name)
+{
+    if(::shm_unlink(segment_name(name).c_str()) != 0 && errno != ENOENT)
+    {
+        throw_errno("shm_unlink " + name);
+    }
+}
+
+shared_triangulation::shared_triangulation(shared_triangulation&& other) noexcept
+    : m_name(std::move(other.m_name)), m_header(std::exchange(other.m_header, nullptr)),
+      m_attached(std::exchange(other.m_attached, false)), m_data(std::exchange(other.m_data, nullptr)),
+      m_data_size(std::exchange(other.m_data_size, 0)), m_view(std::exchange(other.m_view, {}))
+{
+}
+
+shared_triangulation& shared_triangulation::operator=(shared_triangulation&& other) noexcept
+{
+    if(this != &other)
+    {
+        detach();
+        m_name = std::move(other.m_name);
+        m_header = std::exchange(other.m_header, nullptr);
+        m_attached = std::exchange(other.m_attached, false);
+        m_data = std::exchange(other.m_data, nullptr);
+        m_data_size = std::exchange(other.m_data_size, 0);
+        m_view = std::exchange(other.m_view, {});
+    }
+    return *this;
+}
+
+shared_triangulation::~shared_triangulation() { detach(); }
+
+std::uint32_t shared_triangulation::use_count() const
+{
+    return !m_attached ? 0 : static_cast<const shared_header*>(m_header)->users.load(std::memory_order_acquire);
+}
+
+void shared_triangulation::detach() noexcept
+{
+    if(m_data != nullptr)
+    {
+        ::munmap(m_data, m_data_size);
+        m_data = nullptr;
+    }
+    if(m_header != nullptr)
+    {
+        auto* header = static_cast<shared_header*>(m_header);
+        if(m_attached && header->users.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            // the last user unlinks the name, the memory is freed once every process unmapped it
+            ::shm_unlink(m_name.c_str());
+        }
+        ::munmap(m_header, SHARED_VERTEX_OFFSET);
+        m_header = nullptr;
+        m_attached = false;
+    }
+    m_view = {};
+}
+
+}
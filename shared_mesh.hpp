@@ -0,0 +1,69 @@
+#pragma once
+
+#include "triangulation_view.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace half_edge {
+
+/**
+ * Triangulation published in a named POSIX shared-memory segment.
+ * The segment starts with a header page holding the sizes and the number of users, followed by the vertex array
+ * at SHARED_VERTEX_OFFSET and the halfedge array, both mapped read-only by the processes attaching to it.
+ * The segment is unlinked when the last handle is destroyed; a process killed while attached leaks its reference,
+ * use remove() to unlink the segment anyway.
+ */
+class shared_triangulation
+{
+  public:
+    /// offset of the vertex array, a multiple of the page size on every supported system
+    static constexpr std::size_t SHARED_VERTEX_OFFSET = std::size_t{1} << 16U;
+
+    /**
+     * Copies the triangulation into a new shared-memory segment.
+     * @param[in] tri The triangulation to publish
+     * @param[in] name The name of the segment, a leading '/' is added if missing
+     * @return the handle of the publisher, the first user of the segment
+     */
+    [[nodiscard]] static shared_triangulation publish(const Triangulation& tri, const std::string& name);
+
+    /**
+     * Maps a published segment, in constant time as the pages are only loaded when touched.
+     * @param[in] name The name of the segment
+     * @return a new handle on the segment
+     */
+    [[nodiscard]] static shared_triangulation attach(const std::string& name);
+
+    /**
+     * Unlinks a segment whatever its number of users, the mapped handles stay valid.
+     * @param[in] name The name of the segment
+     */
+    static void remove(const std::string& name);
+
+    shared_triangulation(const shared_triangulation&) = delete;
+    shared_triangulation& operator=(const shared_triangulation&) = delete;
+    shared_triangulation(shared_triangulation&& other) noexcept;
+    shared_triangulation& operator=(shared_triangulation&& other) noexcept;
+    ~shared_triangulation();
+
+    [[nodiscard]] const triangulation_view& view() const { return m_view; }
+    [[nodiscard]] const std::string& name() const { return m_name; }
+    // number of handles on the segment in all the processes
+    [[nodiscard]] std::uint32_t use_count() const;
+
+  private:
+    shared_triangulation() = default;
+    void detach() noexcept;
+
+    std::string m_name{};
+    void* m_header{nullptr};
+    /// true once the handle holds a reference on the segment, only then does it give it back and maybe unlink
+    bool m_attached{false};
+    void* m_data{nullptr};
+    std::size_t m_data_size{0};
+    triangulation_view m_view{};
+};
+
+}
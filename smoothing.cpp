@@ -0,0 +1,113 @@
+#include "smoothing.hpp"
+#include "parallel.hpp"
+
+#include <barrier>
+#include <stdexcept>
+#include <thread>
+
+namespace half_edge {
+
+void smooth_coordinates(const vertex_adjacency& adjacency,
+                        std::vector<double>& x,
+                        std::vector<double>& y,
+                        const std::vector<std::uint8_t>& pinned,
+                        const smoothing_options& options)
+{
+    const auto n = x.size();
+    if(y.size() != n || pinned.size() != n || adjacency.offsets.size() != n + 1)
+    {
+        throw std::invalid_argument("coordinates, pinned flags and adjacency sizes do not match");
+    }
+    const std::size_t steps_per_iteration = options.method == smoothing_method::taubin ? 2 : 1;
+    const auto steps = options.iterations * steps_per_iteration;
+    if(n == 0 || steps == 0)
+    {
+        return;
+    }
+
+    // even steps read the front buffers and write the back ones, odd steps the other way around
+    std::vector<double> x_back(n);
+    std::vector<double> y_back(n);
+    const auto* offsets = adjacency.offsets.data();
+    const auto* neighbours = adjacency.neighbours.data();
+
+    const auto n_threads = resolve_threads(options.threads, n);
+    const auto chunk = (n + n_threads - 1) / n_threads;
+    std::barrier sync(static_cast<std::ptrdiff_t>(n_threads));
+    const auto worker = [&](std::size_t begin, std::size_t end)
+    {
+        for(std::size_t s = 0; s < steps; ++s)
+        {
+            const auto weight = s % steps_per_iteration == 0 ? options.lambda : options.mu;
+            const auto* src_x = s % 2 == 0 ? x.data() : x_back.data();
+            const auto* src_y = s % 2 == 0 ? y.data() : y_back.data();
+            auto* dst_x = s % 2 == 0 ? x_back.data() : x.data();
+            auto* dst_y = s % 2 == 0 ? y_back.data() : y.data();
+            for(auto v = begin; v < end; ++v)
+            {
+                const auto row_begin = offsets[v];
+                const auto row_end = offsets[v + 1];
+                if(pinned[v] != 0 || row_begin == row_end)
+                {
+                    dst_x[v] = src_x[v];
+                    dst_y[v] = src_y[v];
+                    continue;
+                }
+                double sum_x{0.};
+                double sum_y{0.};
+                for(auto k = row_begin; k < row_end; ++k)
+                {
+                    sum_x += src_x[neighbours[k]];
+                    sum_y += src_y[neighbours[k]];
+                }
+                const auto inv_degree = 1. / static_cast<double>(row_end - row_begin);
+                dst_x[v] = src_x[v] + weight * (sum_x * inv_degree - src_x[v]);
+                dst_y[v] = src_y[v] + weight * (sum_y * inv_degree - src_y[v]);
+            }
+            sync.arrive_and_wait();
+        }
+    };
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(n_threads - 1);
+        for(std::size_t t = 1; t < n_threads; ++t)
+        {
+            workers.emplace_back(worker, std::min(n, t * chunk), std::min(n, (t + 1) * chunk));
+        }
+        worker(0, std::min(n, chunk));
+    }
+    if(steps % 2 == 1)
+    {
+        x.swap(x_back);
+        y.swap(y_back);
+    }
+}
+
+void smooth(Triangulation& tri, const smoothing_options& options)
+{
+    const auto n = tri.vertex_slots();
+    std::vector<double> x(n, 0.);
+    std::vector<double> y(n, 0.);
+    std::vector<std::uint8_t> pinned(n, 1);
+    for(index v = 0; v < n; ++v)
+    {
+        if(tri.is_vertex_alive(v))
+        {
+            x[v] = tri.get_PointX(v);
+            y[v] = tri.get_PointY(v);
+            pinned[v] = options.pin_border && tri.is_border_vertex(v) ? 1 : 0;
+        }
+    }
+    adjacency_options layout;
+    layout.threads = options.threads;
+    smooth_coordinates(tri.adjacency(layout), x, y, pinned, options);
+    for(index v = 0; v < n; ++v)
+    {
+        if(tri.is_vertex_alive(v))
+        {
+            tri.set_point(v, x[v], y[v]);
+        }
+    }
+}
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Triangulation.hpp"
+#include "adjacency.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace half_edge {
+
+enum class smoothing_method
+{
+    /// umbrella operator, moves each vertex toward the centroid of its neighbours, shrinks the mesh
+    laplacian,
+    /// alternates a shrinking lambda step and an inflating mu step
+    taubin
+};
+
+struct smoothing_options
+{
+    smoothing_method method{smoothing_method::laplacian};
+    std::size_t iterations{1};
+    /// weight of the umbrella operator, in (0, 1]
+    double lambda{0.5};
+    /// weight of the inflating step of Taubin smoothing, negative with |mu| > lambda
+    double mu{-0.53};
+    /// whether the vertices on the boundary keep their position
+    bool pin_border{true};
+    /// number of worker threads, 0 for the hardware concurrency
+    std::size_t threads{0};
+};
+
+/**
+ * Smooths coordinates stored as structure of arrays over a precomputed adjacency.
+ * Each iteration reads one buffer and writes the other one, the workers synchronise on a barrier between steps.
+ *
+ * @param[in] adjacency The vertex adjacency, one row per coordinate
+ * @param[in,out] x The x coordinates
+ * @param[in,out] y The y coordinates
+ * @param[in] pinned Non-zero for the vertices keeping their position
+ * @param[in] options The smoothing method, weights and number of iterations
+ */
+void smooth_coordinates(const vertex_adjacency& adjacency,
+                        std::vector<double>& x,
+                        std::vector<double>& y,
+                        const std::vector<std::uint8_t>& pinned,
+                        const smoothing_options& options);
+
+/**
+ * Smooths the vertex positions of the triangulation, the connectivity is left untouched.
+ * @param[in,out] tri The triangulation
+ * @param[in] options The smoothing method, weights and number of iterations
+ */
+void smooth(Triangulation& tri, const smoothing_options& options);
+
+}
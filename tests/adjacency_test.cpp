@@ -0,0 +1,88 @@
+#include "adjacency.hpp"
+#include "test_meshes.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using half_edge::INVALID_INDEX;
+using half_edge::index;
+using half_edge::test::make_grid;
+
+TEST_CASE("vertex adjacency", "[adjacency]")
+{
+    const auto tri = make_grid(5);
+    half_edge::adjacency_options options;
+    options.threads = GENERATE(1U, 4U);
+    const auto adjacency = half_edge::build_vertex_adjacency(tri, options);
+    REQUIRE(adjacency.offsets.size() == 26);
+    REQUIRE(adjacency.neighbours.size() == tri.halfEdges_size());
+    REQUIRE(adjacency.edges.empty());
+    REQUIRE(adjacency.degree(12) == 6);
+    REQUIRE(adjacency.degree(0) == 3);
+    REQUIRE(adjacency.degree(4) == 2);
+    for(index v = 0; v < 25; ++v)
+    {
+        for(auto k = adjacency.offsets[v]; k < adjacency.offsets[v + 1]; ++k)
+        {
+            REQUIRE(tri.find_halfedge(v, adjacency.neighbours[k]) != INVALID_INDEX);
+        }
+    }
+}
+
+TEST_CASE("sorted adjacency with edge ids and diagonal", "[adjacency]")
+{
+    const auto tri = make_grid(4);
+    half_edge::adjacency_options options;
+    options.sorted = true;
+    options.edge_ids = true;
+    options.include_diagonal = true;
+    options.threads = 3;
+    const auto adjacency = half_edge::build_vertex_adjacency(tri, options);
+    REQUIRE(adjacency.neighbours.size() == tri.halfEdges_size() + 16);
+    REQUIRE(adjacency.edges.size() == adjacency.neighbours.size());
+
+    // vertex 5 is linked to 0, 1, 4, 6, 9 and 10
+    const std::vector<index> row(adjacency.neighbours.begin() + static_cast<std::ptrdiff_t>(adjacency.offsets[5]),
+                                 adjacency.neighbours.begin() + static_cast<std::ptrdiff_t>(adjacency.offsets[6]));
+    REQUIRE(row == std::vector<index>{0, 1, 4, 5, 6, 9, 10});
+    for(index v = 0; v < 16; ++v)
+    {
+        const auto begin = adjacency.neighbours.begin() + static_cast<std::ptrdiff_t>(adjacency.offsets[v]);
+        const auto end = adjacency.neighbours.begin() + static_cast<std::ptrdiff_t>(adjacency.offsets[v + 1]);
+        REQUIRE(std::is_sorted(begin, end));
+        for(auto k = adjacency.offsets[v]; k < adjacency.offsets[v + 1]; ++k)
+        {
+            if(adjacency.neighbours[k] == v)
+            {
+                REQUIRE(adjacency.edges[k] == INVALID_INDEX);
+            }
+            else
+            {
+                REQUIRE(tri.origin(adjacency.edges[k]) == v);
+                REQUIRE(tri.target(adjacency.edges[k]) == adjacency.neighbours[k]);
+            }
+        }
+    }
+}
+
+TEST_CASE("adjacency cached on the triangulation", "[adjacency]")
+{
+    auto tri = make_grid(4);
+    const half_edge::adjacency_options options;
+    const auto* first = &tri.adjacency(options);
+    REQUIRE(&tri.adjacency(options) == first);
+    REQUIRE(first->degree(5) == 6);
+
+    tri.split_edge(tri.find_halfedge(5, 10));
+    const auto& rebuilt = tri.adjacency(options);
+    REQUIRE(rebuilt.offsets.size() == 18);
+    REQUIRE(rebuilt.degree(16) == 4);
+    REQUIRE(rebuilt.degree(5) == 6);
+
+    half_edge::adjacency_options sorted;
+    sorted.sorted = true;
+    REQUIRE(tri.adjacency(sorted).options.sorted);
+}
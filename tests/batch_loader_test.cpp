@@ -0,0 +1,121 @@
+#include "batch_loader.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// writes a strip of 2 n triangles
+std::string write_strip(const fs::path& directory, std::size_t n)
+{
+    const auto path = directory / ("strip_" + std::to_string(n) + ".off");
+    std::ofstream out(path);
+    out << "OFF\n" << 2 * (n + 1) << ' ' << 2 * n << " 0\n";
+    for(std::size_t i = 0; i <= n; ++i)
+    {
+        out << i << " 0 0\n" << i << " 1 0\n";
+    }
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        out << "3 " << 2 * i << ' ' << 2 * i + 2 << ' ' << 2 * i + 3 << '\n';
+        out << "3 " << 2 * i << ' ' << 2 * i + 3 << ' ' << 2 * i + 1 << '\n';
+    }
+    return path.string();
+}
+
+}
+
+TEST_CASE("work-stealing thread pool", "[batch_loader]")
+{
+    std::atomic<std::size_t> count{0};
+    {
+        half_edge::thread_pool pool(4);
+        REQUIRE(pool.size() == 4);
+        for(std::size_t k = 0; k < 100; ++k)
+        {
+            // every task spawns two more from a worker, they land in its own deque
+            pool.submit(
+                [&pool, &count]
+                {
+                    ++count;
+                    for(std::size_t j = 0; j < 2; ++j)
+                    {
+                        pool.submit([&count] { ++count; });
+                    }
+                });
+        }
+    }
+    REQUIRE(count == 300);
+}
+
+TEST_CASE("batch loading of OFF files", "[batch_loader]")
+{
+    const auto directory = fs::temp_directory_path() / ("half_edge_batch_test_" + std::to_string(std::random_device{}()));
+    fs::create_directories(directory);
+    std::vector<std::string> paths;
+    for(std::size_t n = 1; n <= 12; ++n)
+    {
+        paths.push_back(write_strip(directory, n));
+    }
+    paths.push_back((directory / "missing.off").string());
+    {
+        std::ofstream out(directory / "not_off.off");
+        out << "PLY\n3 1 0\n";
+    }
+    paths.push_back((directory / "not_off.off").string());
+
+    half_edge::batch_options options;
+    // small enough to serialize the largest files
+    options.max_in_flight_bytes = GENERATE(std::size_t{1000}, std::size_t{1} << 30U);
+    half_edge::thread_pool pool(3);
+    auto futures = half_edge::load_meshes(pool, paths, options);
+    REQUIRE(futures.size() == paths.size());
+    for(std::size_t n = 1; n <= 12; ++n)
+    {
+        const auto tri = futures[n - 1].get();
+        REQUIRE(tri.faces_size() == 2 * n);
+        REQUIRE(tri.vertices_size() == 2 * (n + 1));
+    }
+    REQUIRE_THROWS_AS(futures[12].get(), std::runtime_error);
+    REQUIRE_THROWS_AS(futures[13].get(), std::invalid_argument);
+    fs::remove_all(directory);
+}
+
+TEST_CASE("futures consumed in any order within a budget of one mesh", "[batch_loader]")
+{
+    const auto directory =
+        fs::temp_directory_path() / ("half_edge_batch_budget_test_" + std::to_string(std::random_device{}()));
+    fs::create_directories(directory);
+    const std::vector<std::string> paths{
+        write_strip(directory, 4), write_strip(directory, 5), write_strip(directory, 6), write_strip(directory, 7)};
+
+    half_edge::batch_options options;
+    // every file is loaded alone
+    options.max_in_flight_bytes = 1;
+    half_edge::thread_pool pool(3);
+    auto futures = half_edge::load_meshes(pool, paths, options);
+    // the first mesh holds the budget until taken, the later files are started when waited for
+    futures[0].wait();
+    for(std::size_t k = futures.size(); k > 0; --k)
+    {
+        REQUIRE(futures[k - 1].get().faces_size() == 2 * (k + 3));
+    }
+
+    // a destroyed future gives its share back as well
+    futures = half_edge::load_meshes(pool, {paths[0], paths[1]}, options);
+    futures[0] = {};
+    REQUIRE(futures[1].get().faces_size() == 10);
+    fs::remove_all(directory);
+}
@@ -0,0 +1,99 @@
+#include "components.hpp"
+#include "test_meshes.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <vector>
+
+using half_edge::INVALID_INDEX;
+using half_edge::index;
+using half_edge::test::is_consistent;
+using half_edge::test::make_grid;
+
+namespace {
+
+// a 3x3 grid, a lone triangle and a pair of triangles sharing an edge
+half_edge::Triangulation make_patches()
+{
+    std::vector<half_edge::vertex> vertices;
+    for(std::size_t j = 0; j < 3; ++j)
+    {
+        for(std::size_t i = 0; i < 3; ++i)
+        {
+            vertices.emplace_back(static_cast<double>(i), static_cast<double>(j));
+        }
+    }
+    vertices.insert(vertices.end(), {{10., 0.}, {11., 0.}, {10., 1.}, {20., 0.}, {21., 0.}, {21., 1.}, {20., 1.}});
+    return {std::move(vertices), {0, 1, 4, 0, 4, 3, 1, 2, 5, 1, 5, 4, 3, 4, 7, 3, 7, 6, 4, 5, 8, 4, 8, 7,
+                                  9, 10, 11, 12, 13, 14, 12, 14, 15}};
+}
+
+}
+
+TEST_CASE("face components", "[components]")
+{
+    const auto tri = make_patches();
+    const auto threads = GENERATE(1U, 4U);
+    const auto components = half_edge::label_face_components(tri, threads);
+    REQUIRE(components.count == 3);
+    const std::vector<index> live_labels(components.labels.begin(), components.labels.begin() + 11);
+    REQUIRE(live_labels == std::vector<index>{0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 2});
+
+    const auto parts = half_edge::split_components(tri, threads);
+    REQUIRE(parts.size() == 3);
+    REQUIRE(parts[0].faces_size() == 8);
+    REQUIRE(parts[0].vertices_size() == 9);
+    REQUIRE(parts[1].faces_size() == 1);
+    REQUIRE(parts[2].faces_size() == 2);
+    REQUIRE(parts[2].get_PointX(0) == Catch::Approx(20.));
+    for(const auto& part : parts)
+    {
+        REQUIRE(is_consistent(part));
+    }
+
+    const auto single = half_edge::extract_component(tri, components, 1);
+    REQUIRE(single.faces_size() == 1);
+    REQUIRE(single.halfEdges_size() == 6);
+}
+
+TEST_CASE("components follow the edits", "[components]")
+{
+    auto tri = make_grid(3);
+    // removing the two faces of the anti-diagonal cells leaves two corners linked only by vertices
+    tri.delete_face(2);
+    tri.delete_face(3);
+    tri.delete_face(4);
+    tri.delete_face(5);
+    const auto components = half_edge::label_face_components(tri);
+    REQUIRE(components.count == 2);
+    REQUIRE(components.labels[2] == INVALID_INDEX);
+    REQUIRE(components.labels[0] == 0);
+    REQUIRE(components.labels[7] == 1);
+}
+
+TEST_CASE("dual graph breadth-first search", "[components]")
+{
+    const auto tri = make_grid(5);
+    const auto threads = GENERATE(1U, 3U);
+    const auto bfs = half_edge::dual_bfs(tri, {0}, threads);
+    REQUIRE(bfs.faces.size() == tri.faces_size());
+    REQUIRE(bfs.distances[0] == 0);
+    REQUIRE(bfs.distances[1] == 1);
+    // face 2 is the lower triangle of the second cell, reached through face 3 across the edge 1 - 6
+    REQUIRE(bfs.distances[3] == 1);
+    REQUIRE(bfs.distances[2] == 2);
+    for(std::size_t d = 0; d + 1 < bfs.layer_offsets.size(); ++d)
+    {
+        for(auto k = bfs.layer_offsets[d]; k < bfs.layer_offsets[d + 1]; ++k)
+        {
+            REQUIRE(bfs.distances[bfs.faces[k]] == d);
+        }
+    }
+
+    const auto patches = make_patches();
+    const auto partial = half_edge::dual_bfs(patches, {8, 9}, threads);
+    REQUIRE(partial.faces.size() == 3);
+    REQUIRE(partial.distances[10] == 1);
+    REQUIRE(partial.distances[0] == INVALID_INDEX);
+}
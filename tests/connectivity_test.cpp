@@ -0,0 +1,87 @@
+#include "adjacency.hpp"
+#include "components.hpp"
+#include "connectivity.hpp"
+#include "test_meshes.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+
+using half_edge::index;
+using half_edge::test::is_consistent;
+using half_edge::test::make_grid;
+
+namespace {
+
+// the backends agree with the triangulation they were built from, which is compacted so the indices are the same
+template<class Mesh>
+bool same_connectivity(const half_edge::Triangulation& tri, const Mesh& mesh)
+{
+    if(mesh.halfEdges_size() != tri.halfEdges_size() || mesh.faces_size() != tri.faces_size() ||
+       mesh.vertices_size() != tri.vertices_size())
+    {
+        return false;
+    }
+    for(index e = 0; e < tri.halfEdges_size(); ++e)
+    {
+        if(mesh.origin(e) != tri.origin(e) || mesh.twin(e) != tri.twin(e) || mesh.next(e) != tri.next(e) ||
+           mesh.prev(e) != tri.prev(e) || mesh.target(e) != tri.target(e) ||
+           mesh.CCW_edge_to_vertex(e) != tri.CCW_edge_to_vertex(e) ||
+           mesh.CW_edge_to_vertex(e) != tri.CW_edge_to_vertex(e) || mesh.is_border_face(e) != tri.is_border_face(e))
+        {
+            return false;
+        }
+    }
+    for(index v = 0; v < tri.vertices_size(); ++v)
+    {
+        if(mesh.edge_of_vertex(v) != tri.edge_of_vertex(v) || mesh.is_border_vertex(v) != tri.is_border_vertex(v))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+static_assert(half_edge::connectivity_backend<half_edge::half_edge_connectivity>);
+static_assert(half_edge::connectivity_backend<half_edge::corner_table_connectivity>);
+static_assert(half_edge::triangulation_like<half_edge::Triangulation>);
+static_assert(half_edge::triangulation_like<half_edge::half_edge_mesh>);
+static_assert(half_edge::triangulation_like<half_edge::corner_table_mesh>);
+
+TEST_CASE("connectivity backends", "[connectivity]")
+{
+    auto tri = make_grid(7);
+    tri.delete_face(20);
+    tri.split_edge(tri.find_halfedge(8, 9));
+    tri.collapse_edge(tri.find_halfedge(30, 31));
+
+    SECTION("on a compacted triangulation")
+    {
+        tri.compact();
+        const half_edge::half_edge_mesh half_edges(tri);
+        const half_edge::corner_table_mesh corners(tri);
+        REQUIRE(same_connectivity(tri, half_edges));
+        REQUIRE(same_connectivity(tri, corners));
+        // 8 bytes per corner plus 16 per exterior halfedge instead of 40 per halfedge
+        REQUIRE(corners.connectivity().memory_bytes() * 3 < half_edges.connectivity().memory_bytes());
+
+        // the algorithms of the library take the meshes as they take the triangulation
+        REQUIRE(is_consistent(corners));
+        const auto adjacency = half_edge::build_vertex_adjacency(tri);
+        REQUIRE(half_edge::build_vertex_adjacency(half_edges).neighbours == adjacency.neighbours);
+        REQUIRE(half_edge::build_vertex_adjacency(corners).neighbours == adjacency.neighbours);
+        REQUIRE(half_edge::label_face_components(corners).labels == half_edge::label_face_components(tri).labels);
+        REQUIRE(half_edge::split_components(corners).front().faces_size() == tri.faces_size());
+    }
+
+    SECTION("released slots are renumbered")
+    {
+        const half_edge::corner_table_mesh corners(tri);
+        REQUIRE(corners.faces_size() == tri.faces_size());
+        REQUIRE(corners.halfEdges_size() == tri.halfEdges_size());
+        tri.compact();
+        REQUIRE(same_connectivity(tri, corners));
+    }
+}
@@ -0,0 +1,116 @@
+#include "decimation.hpp"
+#include "test_meshes.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using half_edge::index;
+using half_edge::test::is_consistent;
+using half_edge::test::make_grid;
+
+namespace {
+
+// total area of the faces, and whether they are all counterclockwise
+std::pair<double, bool> area(const half_edge::Triangulation& tri)
+{
+    double total{0.};
+    bool ccw{true};
+    for(index f = 0; f < tri.faces_size(); ++f)
+    {
+        const auto a = tri.origin(3 * f);
+        const auto b = tri.origin(3 * f + 1);
+        const auto c = tri.origin(3 * f + 2);
+        const auto cross = (tri.get_PointX(b) - tri.get_PointX(a)) * (tri.get_PointY(c) - tri.get_PointY(a)) -
+                           (tri.get_PointY(b) - tri.get_PointY(a)) * (tri.get_PointX(c) - tri.get_PointX(a));
+        total += 0.5 * cross;
+        ccw = ccw && cross > 0.;
+    }
+    return {total, ccw};
+}
+
+std::size_t border_vertices(const half_edge::Triangulation& tri)
+{
+    std::size_t count{0};
+    for(index v = 0; v < tri.vertices_size(); ++v)
+    {
+        count += tri.is_border_vertex(v) ? 1U : 0U;
+    }
+    return count;
+}
+
+}
+
+TEST_CASE("decimation down to a target number of faces", "[decimation]")
+{
+    auto tri = make_grid(20);
+    REQUIRE(tri.faces_size() == 722);
+
+    half_edge::decimation_options options;
+    options.target_faces = 100;
+    options.metric = GENERATE(half_edge::decimation_metric::quadric, half_edge::decimation_metric::edge_length);
+    options.keep_boundary = GENERATE(true, false);
+
+    const auto result = half_edge::decimate(tri, options);
+    REQUIRE(tri.faces_size() <= 100);
+    REQUIRE(result.collapses == 400 - tri.vertices_size());
+    REQUIRE(result.map.vertices.size() == 400);
+    REQUIRE(is_consistent(tri));
+    // compacted
+    REQUIRE(tri.vertex_slots() == tri.vertices_size());
+    REQUIRE(tri.halfEdge_slots() == tri.halfEdges_size());
+
+    const auto [total, ccw] = area(tri);
+    REQUIRE(ccw);
+    if(options.keep_boundary)
+    {
+        REQUIRE(total == Catch::Approx(361.));
+        REQUIRE(border_vertices(tri) == 76);
+        REQUIRE(tri.get_PointX(result.map.vertices.at(19)) == Catch::Approx(19.));
+    }
+    else if(options.metric == half_edge::decimation_metric::quadric)
+    {
+        // the boundary lines keep the square
+        REQUIRE(total == Catch::Approx(361.).epsilon(1e-3));
+    }
+}
+
+TEST_CASE("decimation stops at the maximum error", "[decimation]")
+{
+    auto tri = make_grid(10);
+    half_edge::decimation_options options;
+    options.metric = half_edge::decimation_metric::edge_length;
+    options.max_error = 0.5;
+    const auto result = half_edge::decimate(tri, options);
+    REQUIRE(result.collapses == 0);
+    REQUIRE(tri.faces_size() == 162);
+
+    options.max_error = 1.5;
+    const auto coarse = half_edge::decimate(tri, options);
+    REQUIRE(coarse.collapses > 0);
+    REQUIRE(coarse.max_error <= 1.5);
+    REQUIRE(is_consistent(tri));
+}
+
+TEST_CASE("decimation retries the collapses rejected earlier", "[decimation]")
+{
+    // the shortest edge p-q is rejected, p and q have a third common neighbour r around the degree 3 vertex a
+    // r, e, t, w on the boundary, then p, q and a inside
+    std::vector<half_edge::vertex> vertices{{0., 0.}, {2., 2.}, {0., 4.}, {-2., 2.}, {-0.3, 2.}, {0.3, 2.}, {0., 0.7}};
+    const std::vector<index> faces{0, 1, 5, 1, 2, 5, 2, 4, 5, 2, 3, 4, 3, 0, 4, 0, 5, 6, 5, 4, 6, 4, 0, 6};
+    half_edge::Triangulation tri(std::move(vertices), faces);
+    REQUIRE_FALSE(tri.is_collapse_ok(tri.find_halfedge(4, 5)));
+
+    // only p-q and a-r are cheap enough, collapsing a-r makes p-q collapsible
+    half_edge::decimation_options options;
+    options.metric = half_edge::decimation_metric::edge_length;
+    options.max_error = 1.;
+    options.target_faces = 4;
+    const auto result = half_edge::decimate(tri, options);
+    REQUIRE(result.collapses == 2);
+    REQUIRE(tri.faces_size() == 4);
+    REQUIRE(is_consistent(tri));
+    REQUIRE(area(tri).second);
+}
@@ -0,0 +1,177 @@
+#include "memory_resources.hpp"
+#include "test_meshes.hpp"
+#include "welding.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+using half_edge::test::is_consistent;
+using half_edge::test::make_grid;
+
+namespace {
+
+// counts the blocks and bytes handed out by the new/delete resource
+class counting_resource : public std::pmr::memory_resource
+{
+  public:
+    std::size_t allocations{0};
+    std::size_t outstanding{0};
+
+  private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations;
+        outstanding += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        outstanding -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+// vertices and faces of the n x n grid
+void grid_arrays(std::size_t n, std::vector<half_edge::vertex>& vertices, std::vector<half_edge::index>& faces)
+{
+    const auto grid = make_grid(n);
+    vertices.assign(grid.vertex_storage().begin(), grid.vertex_storage().end());
+    for(half_edge::index f = 0; f < grid.faces_size(); ++f)
+    {
+        faces.insert(faces.end(), {grid.origin(3 * f), grid.origin(3 * f + 1), grid.origin(3 * f + 2)});
+    }
+}
+
+// writes a strip of 2 n triangles in the given format
+std::string write_strip(const std::string& name, std::size_t n, bool ply)
+{
+    const auto path = fs::temp_directory_path() / ("he_memory_resources_test_" + name);
+    std::ofstream out(path);
+    if(ply)
+    {
+        out << "ply\nformat ascii 1.0\nelement vertex " << 2 * (n + 1) << "\nproperty float x\nproperty float y\n"
+            << "element face " << 2 * n << "\nproperty list uchar int vertex_indices\nend_header\n";
+    }
+    else
+    {
+        out << "OFF\n" << 2 * (n + 1) << ' ' << 2 * n << " 0\n";
+    }
+    for(std::size_t i = 0; i <= n; ++i)
+    {
+        out << i << " 0" << (ply ? "\n" : " 0\n") << i << " 1" << (ply ? "\n" : " 0\n");
+    }
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        out << "3 " << 2 * i << ' ' << 2 * i + 2 << ' ' << 2 * i + 3 << '\n';
+        out << "3 " << 2 * i << ' ' << 2 * i + 3 << ' ' << 2 * i + 1 << '\n';
+    }
+    return path.string();
+}
+
+}
+
+TEST_CASE("construction temporaries are released with the arena", "[memory_resources]")
+{
+    const bool ply = GENERATE(false, true);
+    const auto path = write_strip(ply ? "strip.ply" : "strip.off", 1000, ply);
+    counting_resource scratch;
+    counting_resource storage;
+    {
+        const half_edge::Triangulation tri(path, half_edge::welding_options{}, {&scratch, &storage});
+        REQUIRE(tri.faces_size() == 2000);
+        REQUIRE(is_consistent(tri));
+        // the faces, the welding buffers and the line buffer came from the arena, all given back
+        REQUIRE(scratch.allocations > 0);
+        REQUIRE(scratch.outstanding == 0);
+        // only the arrays are kept, the map of the edges finding the twins was a temporary of the arena
+        const auto arrays = tri.vertex_storage().size_bytes() + tri.halfEdge_storage().size_bytes();
+        REQUIRE(storage.outstanding >= arrays);
+        REQUIRE(storage.outstanding <= arrays + tri.vertex_storage().size_bytes());
+        REQUIRE_FALSE(tri.has_edge_index());
+    }
+    REQUIRE(storage.outstanding == 0);
+    fs::remove(path);
+}
+
+TEST_CASE("triangulation arrays in a caller resource", "[memory_resources]")
+{
+    std::vector<half_edge::vertex> vertices;
+    std::vector<half_edge::index> faces;
+    grid_arrays(20, vertices, faces);
+
+    counting_resource scratch;
+    counting_resource storage;
+    {
+        half_edge::Triangulation tri(vertices, faces, {&scratch, &storage});
+        REQUIRE(is_consistent(tri));
+        REQUIRE(scratch.allocations > 0);
+        REQUIRE(scratch.outstanding == 0);
+        REQUIRE(storage.outstanding == tri.vertex_storage().size_bytes() + tri.halfEdge_storage().size_bytes());
+        const auto built = storage.allocations;
+
+        // the edits and the compaction keep allocating from the storage
+        tri.delete_face(0);
+        tri.split_edge(tri.find_halfedge(200, 201));
+        tri.compact();
+        REQUIRE(is_consistent(tri));
+        REQUIRE(storage.allocations > built);
+
+        // a copy lives in the default resource, a moved triangulation keeps the storage
+        const auto outstanding = storage.outstanding;
+        const half_edge::Triangulation copy(tri);
+        REQUIRE(storage.outstanding == outstanding);
+        const half_edge::Triangulation moved(std::move(tri));
+        REQUIRE(storage.outstanding == outstanding);
+        REQUIRE(is_consistent(moved));
+        REQUIRE(moved.faces_size() == copy.faces_size());
+    }
+    REQUIRE(storage.outstanding == 0);
+}
+
+TEST_CASE("hugepage resource", "[memory_resources]")
+{
+    counting_resource upstream;
+    half_edge::hugepage_resource resource(&upstream);
+    REQUIRE(resource.upstream_resource() == &upstream);
+    REQUIRE(resource.is_equal(half_edge::hugepage_resource(&upstream)));
+
+    // small blocks come from the upstream resource
+    void* small = resource.allocate(1024, 16);
+    REQUIRE(upstream.outstanding == 1024);
+    resource.deallocate(small, 1024, 16);
+    REQUIRE(upstream.outstanding == 0);
+
+    constexpr std::size_t size = 3 * half_edge::hugepage_resource::HUGE_PAGE_SIZE + 100;
+    auto* large = static_cast<unsigned char*>(resource.allocate(size, 64));
+    std::memset(large, 0xAB, size);
+    REQUIRE(large[size - 1] == 0xAB);
+#if defined(__unix__) || defined(__APPLE__)
+    REQUIRE(upstream.outstanding == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(large) % half_edge::hugepage_resource::HUGE_PAGE_SIZE == 0);
+#endif
+    resource.deallocate(large, size, 64);
+    REQUIRE(upstream.outstanding == 0);
+
+    // the arrays of a large grid are mapped
+    std::vector<half_edge::vertex> vertices;
+    std::vector<half_edge::index> faces;
+    grid_arrays(300, vertices, faces);
+    const half_edge::Triangulation tri(vertices, faces, {.storage = &resource});
+    REQUIRE(is_consistent(tri));
+}
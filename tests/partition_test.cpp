@@ -0,0 +1,264 @@
+#include "partition.hpp"
+#include "test_meshes.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using half_edge::INVALID_INDEX;
+using half_edge::index;
+using half_edge::test::is_consistent;
+using half_edge::test::make_grid;
+
+namespace {
+
+std::size_t count_cuts(const half_edge::mesh_partition& partition)
+{
+    std::size_t cuts = 0;
+    for(const auto& part : partition.parts)
+    {
+        for(const auto c : part.is_cut)
+        {
+            cuts += c;
+        }
+    }
+    return cuts;
+}
+
+// every vertex has a single fan: the walk around it meets all its faces and at most one exterior halfedge
+bool single_fans(const half_edge::Triangulation& mesh)
+{
+    std::vector<std::size_t> incident(mesh.vertices_size(), 0);
+    for(index f = 0; f < mesh.faces_size(); ++f)
+    {
+        for(std::size_t j = 0; j < 3; ++j)
+        {
+            ++incident[mesh.origin(3 * f + j)];
+        }
+    }
+    for(index v = 0; v < mesh.vertices_size(); ++v)
+    {
+        std::size_t faces = 0;
+        std::size_t exterior = 0;
+        const auto start = mesh.edge_of_vertex(v);
+        auto e = start;
+        do
+        {
+            ++(mesh.is_border_face(e) ? exterior : faces);
+            e = mesh.CCW_edge_to_vertex(e);
+        } while(e != start);
+        if(faces != incident[v] || exterior > 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+TEST_CASE("space-filling-curve partition", "[partition]")
+{
+    const auto tri = make_grid(9);
+    half_edge::partition_options options;
+    options.parts = 4;
+    options.curve = GENERATE(half_edge::space_filling_curve::morton, half_edge::space_filling_curve::hilbert);
+    options.threads = GENERATE(1U, 4U);
+    const auto partition = half_edge::partition_mesh(tri, options);
+    REQUIRE(partition.parts.size() == 4);
+
+    std::vector<std::size_t> owners(tri.face_slots(), 0);
+    std::vector<std::size_t> incident_faces(tri.vertex_slots(), 0);
+    for(index f = 0; f < tri.faces_size(); ++f)
+    {
+        for(std::size_t j = 0; j < 3; ++j)
+        {
+            ++incident_faces[tri.origin(3 * f + j)];
+        }
+    }
+    for(index p = 0; p < partition.parts.size(); ++p)
+    {
+        const auto& part = partition.parts[p];
+        const auto& mesh = part.mesh;
+        REQUIRE(is_consistent(mesh));
+        REQUIRE(part.owned_faces == 32);
+        REQUIRE(mesh.faces_size() == part.face_to_global.size());
+        REQUIRE(mesh.faces_size() > part.owned_faces);
+        for(index f = 0; f < part.owned_faces; ++f)
+        {
+            ++owners[part.face_to_global[f]];
+            REQUIRE(partition.face_parts[part.face_to_global[f]] == p);
+            REQUIRE(partition.face_owner_local[part.face_to_global[f]] == f);
+        }
+        for(index e = 0; e < mesh.halfEdge_slots(); ++e)
+        {
+            if(!mesh.is_halfEdge_alive(e))
+            {
+                continue;
+            }
+            const auto global = part.half_edge_to_global[e];
+            REQUIRE(tri.origin(global) == part.vertex_to_global[mesh.origin(e)]);
+            REQUIRE(tri.target(global) == part.vertex_to_global[mesh.target(e)]);
+            if(part.is_cut[e] == 1)
+            {
+                REQUIRE(mesh.is_border_face(e));
+                REQUIRE_FALSE(tri.is_border_face(global));
+                REQUIRE(partition.face_parts[global / 3] != p);
+            }
+            else if(mesh.is_border_face(e))
+            {
+                REQUIRE(tri.is_border_face(global));
+            }
+        }
+        // the one-ring of every owned vertex is complete
+        std::vector<std::size_t> local_incident(mesh.vertices_size(), 0);
+        for(index f = 0; f < mesh.faces_size(); ++f)
+        {
+            for(std::size_t j = 0; j < 3; ++j)
+            {
+                ++local_incident[mesh.origin(3 * f + j)];
+            }
+        }
+        for(index v = 0; v < part.owned_vertices; ++v)
+        {
+            REQUIRE(partition.vertex_parts[part.vertex_to_global[v]] == p);
+            REQUIRE(local_incident[v] == incident_faces[part.vertex_to_global[v]]);
+        }
+        for(auto v = part.owned_vertices; v < mesh.vertices_size(); ++v)
+        {
+            REQUIRE(partition.vertex_parts[part.vertex_to_global[v]] != p);
+        }
+    }
+    for(index f = 0; f < tri.faces_size(); ++f)
+    {
+        REQUIRE(owners[f] == 1);
+    }
+    REQUIRE(count_cuts(partition) > 0);
+}
+
+TEST_CASE("halo exchange", "[partition]")
+{
+    const auto tri = make_grid(7);
+    half_edge::partition_options options;
+    options.parts = 3;
+    const auto partition = half_edge::partition_mesh(tri, options);
+
+    std::vector<std::vector<index>> vertex_values(partition.parts.size());
+    std::vector<std::vector<double>> face_values(partition.parts.size());
+    for(index p = 0; p < partition.parts.size(); ++p)
+    {
+        const auto& part = partition.parts[p];
+        vertex_values[p].assign(part.vertex_to_global.size(), INVALID_INDEX);
+        face_values[p].assign(part.face_to_global.size(), -1.);
+        for(index v = 0; v < part.owned_vertices; ++v)
+        {
+            vertex_values[p][v] = part.vertex_to_global[v];
+        }
+        for(index f = 0; f < part.owned_faces; ++f)
+        {
+            face_values[p][f] = static_cast<double>(part.face_to_global[f]);
+        }
+    }
+    half_edge::exchange_vertex_halo(partition, vertex_values, 2);
+    half_edge::exchange_face_halo(partition, face_values);
+    for(index p = 0; p < partition.parts.size(); ++p)
+    {
+        const auto& part = partition.parts[p];
+        REQUIRE(vertex_values[p] == part.vertex_to_global);
+        for(index f = 0; f < part.face_to_global.size(); ++f)
+        {
+            REQUIRE(face_values[p][f] == Catch::Approx(static_cast<double>(part.face_to_global[f])));
+        }
+    }
+
+    vertex_values.pop_back();
+    REQUIRE_THROWS_AS(half_edge::exchange_vertex_halo(partition, vertex_values), std::invalid_argument);
+}
+
+TEST_CASE("boundary refinement", "[partition]")
+{
+    auto tri = make_grid(12);
+    tri.delete_face(40);
+    half_edge::partition_options options;
+    options.parts = 5;
+    options.curve = half_edge::space_filling_curve::morton;
+    const auto coarse = half_edge::partition_mesh(tri, options);
+    options.refinement_passes = 4;
+    options.imbalance = 0.1;
+    const auto refined = half_edge::partition_mesh(tri, options);
+    REQUIRE(count_cuts(refined) <= count_cuts(coarse));
+    REQUIRE(refined.face_parts[40] == INVALID_INDEX);
+    const auto ideal = static_cast<double>(tri.faces_size()) / 5;
+    for(const auto& part : refined.parts)
+    {
+        REQUIRE(static_cast<double>(part.owned_faces) <= ideal * 1.1 + 1);
+        REQUIRE(static_cast<double>(part.owned_faces) >= ideal * 0.9 - 1);
+        REQUIRE(is_consistent(part.mesh));
+    }
+}
+
+TEST_CASE("degenerate partitions", "[partition]")
+{
+    const auto tri = make_grid(2);
+    half_edge::partition_options options;
+    options.parts = 0;
+    REQUIRE_THROWS_AS(half_edge::partition_mesh(tri, options), std::invalid_argument);
+
+    options.parts = 3;
+    const auto partition = half_edge::partition_mesh(tri, options);
+    std::size_t owned = 0;
+    for(const auto& part : partition.parts)
+    {
+        owned += part.owned_faces;
+    }
+    REQUIRE(owned == 2);
+    REQUIRE(partition.parts[2].owned_faces == 0);
+    REQUIRE(partition.parts[2].mesh.faces_size() == 0);
+}
+
+TEST_CASE("ghost vertices with a split one-ring", "[partition]")
+{
+    // part 0 owns two faces on either side of the vertex 14, whose one-ring then touches the part in two fans
+    const auto tri = make_grid(6);
+    std::vector<index> face_parts(tri.face_slots(), INVALID_INDEX);
+    std::fill_n(face_parts.begin(), tri.faces_size(), 1);
+    face_parts[20] = 0;
+    face_parts[26] = 0;
+    half_edge::partition_options options;
+    const auto partition = half_edge::partition_mesh(tri, face_parts, options);
+    REQUIRE(partition.vertex_parts[14] == 1);
+
+    for(index p = 0; p < partition.parts.size(); ++p)
+    {
+        const auto& part = partition.parts[p];
+        const auto& mesh = part.mesh;
+        REQUIRE(is_consistent(mesh));
+        REQUIRE(single_fans(mesh));
+        for(index e = 0; e < mesh.halfEdge_slots(); ++e)
+        {
+            const auto global = part.half_edge_to_global[e];
+            REQUIRE(tri.origin(global) == part.vertex_to_global[mesh.origin(e)]);
+            REQUIRE(tri.target(global) == part.vertex_to_global[mesh.target(e)]);
+            if(mesh.is_border_face(e))
+            {
+                // the exterior halfedges are either cut by the ghost layer or on the border of the mesh
+                REQUIRE((part.is_cut[e] == 1) != tri.is_border_face(global));
+            }
+        }
+    }
+    // the 21 faces sharing a vertex with the owned ones, plus one of the two faces between the fans of 14
+    const auto& ghosted = partition.parts[0];
+    REQUIRE(ghosted.owned_faces == 2);
+    const auto ghost_vertices = ghosted.vertex_to_global.begin() + static_cast<std::ptrdiff_t>(ghosted.owned_vertices);
+    REQUIRE(std::ranges::binary_search(ghost_vertices, ghosted.vertex_to_global.end(), 14));
+    const auto ghost_faces = ghosted.face_to_global.size() - ghosted.owned_faces;
+    REQUIRE(ghost_faces == 22);
+
+    face_parts[20] = 2;
+    REQUIRE_THROWS_AS(half_edge::partition_mesh(tri, face_parts, options), std::invalid_argument);
+    face_parts.pop_back();
+    REQUIRE_THROWS_AS(half_edge::partition_mesh(tri, face_parts, options), std::invalid_argument);
+}
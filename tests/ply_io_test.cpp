@@ -0,0 +1,196 @@
+#include "ply_io.hpp"
+#include "test_meshes.hpp"
+#include "welding.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+using half_edge::vertex;
+using half_edge::test::is_consistent;
+
+namespace {
+
+fs::path temp_file(const std::string& name) { return fs::temp_directory_path() / ("he_ply_test_" + name + ".ply"); }
+
+// appends a value in the given byte order
+template<class T>
+void put(std::string& out, T value, bool big_endian)
+{
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    if(big_endian != (std::endian::native == std::endian::big))
+    {
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+    out.append(bytes, sizeof(T));
+}
+
+// a unit square in two triangles, with properties around the columns read
+std::string square_binary(bool big_endian, bool quad = false)
+{
+    std::string out = "ply\nformat ";
+    out += big_endian ? "binary_big_endian" : "binary_little_endian";
+    out += " 1.0\ncomment exported\nelement vertex 4\nproperty float x\nproperty float y\nproperty float z\n"
+           "property uchar red\nelement face ";
+    out += quad ? "1" : "2";
+    out += "\nproperty list uchar int vertex_indices\nproperty ushort material\nelement edge 1\n"
+           "property int vertex1\nproperty int vertex2\nend_header\n";
+    const float coordinates[4][2] = {{0.f, 0.f}, {1.f, 0.f}, {1.f, 1.f}, {0.f, 1.f}};
+    for(const auto& c : coordinates)
+    {
+        put(out, c[0], big_endian);
+        put(out, c[1], big_endian);
+        put(out, 0.f, big_endian);
+        put(out, std::uint8_t{255}, big_endian);
+    }
+    if(quad)
+    {
+        put(out, std::uint8_t{4}, big_endian);
+        for(std::int32_t v : {0, 1, 2, 3})
+        {
+            put(out, v, big_endian);
+        }
+        put(out, std::uint16_t{0}, big_endian);
+    }
+    else
+    {
+        for(const auto& face : {std::array<std::int32_t, 3>{0, 1, 2}, std::array<std::int32_t, 3>{0, 2, 3}})
+        {
+            put(out, std::uint8_t{3}, big_endian);
+            for(const auto v : face)
+            {
+                put(out, v, big_endian);
+            }
+            put(out, std::uint16_t{7}, big_endian);
+        }
+    }
+    put(out, std::int32_t{0}, big_endian);
+    put(out, std::int32_t{1}, big_endian);
+    return out;
+}
+
+void write(const fs::path& path, const std::string& content)
+{
+    std::ofstream out(path, std::ios::binary);
+    out << content;
+}
+
+}
+
+TEST_CASE("parse a PLY header", "[ply_io]")
+{
+    constexpr std::string_view text = "ply\r\nformat binary_little_endian 1.0\r\nelement vertex 3\r\n"
+                                      "property double x\r\nproperty double y\r\nelement face 1\r\n"
+                                      "property list uchar uint vertex_index\r\nend_header\r\nrest";
+    const auto header = half_edge::parse_ply_header(text);
+    REQUIRE(header.format == half_edge::ply_format::binary_little_endian);
+    REQUIRE(header.elements.size() == 2);
+    REQUIRE(header.elements[0].count == 3);
+    REQUIRE(header.elements[0].properties[1].type == half_edge::ply_type::float64);
+    REQUIRE(header.elements[1].properties[0].is_list);
+    REQUIRE(header.elements[1].properties[0].count_type == half_edge::ply_type::uint8);
+    REQUIRE(header.elements[1].properties[0].type == half_edge::ply_type::uint32);
+    REQUIRE(header.body_offset == text.find("rest"));
+
+    REQUIRE_THROWS_AS(half_edge::parse_ply_header("OFF\n"), std::invalid_argument);
+    REQUIRE_THROWS_AS(half_edge::parse_ply_header("ply\nformat ascii 1.0\nelement vertex 3\n"), std::invalid_argument);
+    REQUIRE_THROWS_AS(half_edge::parse_ply_header("ply\nformat ascii 1.0\nproperty float x\nend_header\n"),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(
+        half_edge::parse_ply_header("ply\nformat ascii 1.0\nelement vertex 1\nproperty half x\nend_header\n"),
+        std::invalid_argument);
+}
+
+TEST_CASE("read binary PLY files", "[ply_io]")
+{
+    const bool big_endian = GENERATE(false, true);
+    const auto path = temp_file(big_endian ? "big" : "little");
+    write(path, square_binary(big_endian));
+    REQUIRE(half_edge::is_ply_file(path.string()));
+
+    std::vector<vertex> vertices;
+    std::vector<half_edge::index> faces;
+    half_edge::read_PLYfile(path.string(), vertices, faces, 2);
+    REQUIRE(vertices.size() == 4);
+    REQUIRE(vertices[2].x == Catch::Approx(1.));
+    REQUIRE(vertices[2].y == Catch::Approx(1.));
+    REQUIRE(vertices[3].x == Catch::Approx(0.));
+    REQUIRE(faces == std::vector<half_edge::index>{0, 1, 2, 0, 2, 3});
+
+    const half_edge::Triangulation tri(path.string());
+    REQUIRE(tri.vertices_size() == 4);
+    REQUIRE(tri.faces_size() == 2);
+    REQUIRE(is_consistent(tri));
+    fs::remove(path);
+}
+
+TEST_CASE("read ASCII PLY files", "[ply_io]")
+{
+    const auto path = temp_file("ascii");
+    write(path,
+          "ply\nformat ascii 1.0\nelement vertex 4\nproperty float y\nproperty list uchar float normal\n"
+          "property float x\nelement face 2\nproperty list uchar int vertex_indices\nend_header\n"
+          "0 2 0 1 0\n0 0 1\n1 1 0.5 1\n1 0 -2.5e-1\n3 0 1 2\n3 0 2 3\n");
+    std::vector<vertex> vertices;
+    std::vector<half_edge::index> faces;
+    half_edge::read_PLYfile(path.string(), vertices, faces);
+    REQUIRE(vertices.size() == 4);
+    REQUIRE(vertices[1].x == Catch::Approx(1.));
+    REQUIRE(vertices[3].x == Catch::Approx(-0.25));
+    REQUIRE(vertices[3].y == Catch::Approx(1.));
+    REQUIRE(faces == std::vector<half_edge::index>{0, 1, 2, 0, 2, 3});
+    fs::remove(path);
+}
+
+TEST_CASE("invalid PLY files", "[ply_io]")
+{
+    std::vector<vertex> vertices;
+    std::vector<half_edge::index> faces;
+    const auto path = temp_file("invalid");
+
+    write(path, square_binary(false, true));
+    REQUIRE_THROWS_AS(half_edge::read_PLYfile(path.string(), vertices, faces), std::invalid_argument);
+
+    auto truncated = square_binary(false);
+    truncated.resize(truncated.size() - 12);
+    write(path, truncated);
+    REQUIRE_THROWS_AS(half_edge::read_PLYfile(path.string(), vertices, faces), std::invalid_argument);
+
+    write(path, "ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\nproperty float y\nelement face 1\n"
+                "property list uchar int vertex_indices\nend_header\n0 0\n3 0 -1 0\n");
+    REQUIRE_THROWS_AS(half_edge::read_PLYfile(path.string(), vertices, faces), std::invalid_argument);
+
+    // element counts are bounded before allocating: 3 times this one wraps around, the other exceeds the body
+    const std::string ascii_faces = "ply\nformat ascii 1.0\nelement vertex 3\nproperty float x\nproperty float y\n"
+                                    "property list uchar int vertex_indices\nend_header\n0 0\n1 0\n0 1\n3 0 1 2\n";
+    for(const auto* count : {"6148914691236517206", "1000000000000"})
+    {
+        auto text = ascii_faces;
+        text.insert(text.find("property list"), std::string("element face ") + count + "\n");
+        write(path, text);
+        REQUIRE_THROWS_AS(half_edge::read_PLYfile(path.string(), vertices, faces), std::invalid_argument);
+
+        auto binary = square_binary(false);
+        binary.replace(binary.find("element face 2"), 14, std::string("element face ") + count);
+        write(path, binary);
+        REQUIRE_THROWS_AS(half_edge::read_PLYfile(path.string(), vertices, faces), std::invalid_argument);
+    }
+
+    write(path, "OFF\n3 1 0\n");
+    REQUIRE_FALSE(half_edge::is_ply_file(path.string()));
+    REQUIRE_THROWS_AS(half_edge::read_PLYfile(path.string(), vertices, faces), std::invalid_argument);
+    fs::remove(path);
+    REQUIRE_THROWS(half_edge::read_PLYfile(path.string(), vertices, faces));
+}
@@ -0,0 +1,141 @@
+#include "adjacency.hpp"
+#include "components.hpp"
+#include "shared_mesh.hpp"
+#include "test_meshes.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using half_edge::index;
+using half_edge::test::make_grid;
+
+namespace {
+
+bool same_mesh(const half_edge::Triangulation& tri, const half_edge::triangulation_view& view)
+{
+    if(view.faces_size() != tri.faces_size() || view.halfEdges_size() != tri.halfEdges_size() ||
+       view.vertices_size() != tri.vertices_size() || view.halfEdge_slots() != tri.halfEdge_slots())
+    {
+        return false;
+    }
+    for(index e = 0; e < tri.halfEdge_slots(); ++e)
+    {
+        if(view.is_halfEdge_alive(e) != tri.is_halfEdge_alive(e))
+        {
+            return false;
+        }
+        if(tri.is_halfEdge_alive(e) &&
+           (view.origin(e) != tri.origin(e) || view.twin(e) != tri.twin(e) || view.next(e) != tri.next(e) ||
+            view.prev(e) != tri.prev(e) || view.is_border_face(e) != tri.is_border_face(e) ||
+            view.CCW_edge_to_vertex(e) != tri.CCW_edge_to_vertex(e)))
+        {
+            return false;
+        }
+    }
+    for(index v = 0; v < tri.vertex_slots(); ++v)
+    {
+        if(tri.is_vertex_alive(v) &&
+           (view.edge_of_vertex(v) != tri.edge_of_vertex(v) || view.is_border_vertex(v) != tri.is_border_vertex(v) ||
+            view.get_PointX(v) < tri.get_PointX(v) || view.get_PointX(v) > tri.get_PointX(v)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+TEST_CASE("triangulation view", "[shared_mesh]")
+{
+    auto tri = make_grid(4);
+    tri.delete_face(3);
+    const half_edge::triangulation_view view(tri);
+    REQUIRE(same_mesh(tri, view));
+    REQUIRE_FALSE(view.is_face_alive(3));
+    REQUIRE(half_edge::build_vertex_adjacency(view).neighbours == half_edge::build_vertex_adjacency(tri).neighbours);
+    REQUIRE(half_edge::label_face_components(view).count == 1);
+}
+
+TEST_CASE("shared-memory triangulation", "[shared_mesh]")
+{
+    const auto name = "he_shared_test_" + std::to_string(::getpid());
+    auto tri = make_grid(6);
+    tri.delete_face(7);
+    {
+        const auto published = half_edge::shared_triangulation::publish(tri, name);
+        REQUIRE(published.use_count() == 1);
+        REQUIRE(same_mesh(tri, published.view()));
+        REQUIRE_THROWS_AS(half_edge::shared_triangulation::publish(tri, name), std::system_error);
+
+        {
+            const auto attached = half_edge::shared_triangulation::attach(name);
+            REQUIRE(published.use_count() == 2);
+            REQUIRE(same_mesh(tri, attached.view()));
+        }
+        REQUIRE(published.use_count() == 1);
+
+        // another process attaches, checks the mesh and leaves
+        const auto child = ::fork();
+        REQUIRE(child >= 0);
+        if(child == 0)
+        {
+            int status = 1;
+            try
+            {
+                const auto attached = half_edge::shared_triangulation::attach(name);
+                status = same_mesh(tri, attached.view()) && attached.use_count() == 2 ? 0 : 1;
+            }
+            catch(...)
+            {
+            }
+            ::_exit(status);
+        }
+        int status = -1;
+        REQUIRE(::waitpid(child, &status, 0) == child);
+        REQUIRE(WIFEXITED(status));
+        REQUIRE(WEXITSTATUS(status) == 0);
+        REQUIRE(published.use_count() == 1);
+
+        auto moved = half_edge::shared_triangulation::attach(name);
+        auto target = std::move(moved);
+        REQUIRE(target.use_count() == 2);
+        REQUIRE(target.view().faces_size() == tri.faces_size());
+    }
+    // the last user unlinked the segment
+    REQUIRE_THROWS_AS(half_edge::shared_triangulation::attach(name), std::system_error);
+    REQUIRE_NOTHROW(half_edge::shared_triangulation::remove(name));
+    REQUIRE_THROWS_AS(half_edge::shared_triangulation::attach("bad/name"), std::invalid_argument);
+}
+
+TEST_CASE("attaching to an incompatible segment leaves it untouched", "[shared_mesh]")
+{
+    const auto name = "/he_shared_foreign_" + std::to_string(::getpid());
+    constexpr auto size = half_edge::shared_triangulation::SHARED_VERTEX_OFFSET;
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    REQUIRE(fd >= 0);
+    REQUIRE(::ftruncate(fd, size) == 0);
+    auto* mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    REQUIRE(mapped != MAP_FAILED);
+    // every byte of the header set, a wrong magic number with a non-zero use count
+    auto* bytes = static_cast<unsigned char*>(mapped);
+    std::fill_n(bytes, size, 1);
+
+    REQUIRE_THROWS_AS(half_edge::shared_triangulation::attach(name), std::runtime_error);
+    REQUIRE(std::all_of(bytes, bytes + size, [](unsigned char b) { return b == 1; }));
+    const int still_there = ::shm_open(name.c_str(), O_RDONLY, 0);
+    REQUIRE(still_there >= 0);
+    ::close(still_there);
+    ::munmap(mapped, size);
+    half_edge::shared_triangulation::remove(name);
+}
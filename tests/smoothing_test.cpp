@@ -0,0 +1,83 @@
+#include "smoothing.hpp"
+#include "test_meshes.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using half_edge::index;
+using half_edge::test::make_grid;
+
+namespace {
+
+double width(const half_edge::Triangulation& tri)
+{
+    double min_x{tri.get_PointX(0)};
+    double max_x{min_x};
+    for(index v = 1; v < tri.vertices_size(); ++v)
+    {
+        min_x = std::min(min_x, tri.get_PointX(v));
+        max_x = std::max(max_x, tri.get_PointX(v));
+    }
+    return max_x - min_x;
+}
+
+}
+
+TEST_CASE("laplacian smoothing", "[smoothing]")
+{
+    auto tri = make_grid(5);
+    tri.set_point(12, 2.6, 2.4);
+
+    half_edge::smoothing_options options;
+    options.lambda = 1.;
+    options.threads = GENERATE(1U, 3U);
+    half_edge::smooth(tri, options);
+    REQUIRE(tri.get_PointX(12) == Catch::Approx(2.));
+    REQUIRE(tri.get_PointY(12) == Catch::Approx(2.));
+
+    options.iterations = 20;
+    options.lambda = 0.5;
+    half_edge::smooth(tri, options);
+    REQUIRE(width(tri) == Catch::Approx(4.));
+    REQUIRE(tri.get_PointX(4) == Catch::Approx(4.));
+    REQUIRE(tri.get_PointY(24) == Catch::Approx(4.));
+}
+
+TEST_CASE("taubin smoothing shrinks less than laplacian smoothing", "[smoothing]")
+{
+    auto laplacian = make_grid(8);
+    auto taubin = make_grid(8);
+    half_edge::smoothing_options options;
+    options.pin_border = false;
+    options.iterations = 10;
+    options.threads = 2;
+    half_edge::smooth(laplacian, options);
+    options.method = half_edge::smoothing_method::taubin;
+    half_edge::smooth(taubin, options);
+    REQUIRE(width(laplacian) < 7.);
+    REQUIRE(width(taubin) > width(laplacian));
+}
+
+TEST_CASE("smoothing on raw coordinates", "[smoothing]")
+{
+    // path 0 - 1 - 2 with pinned ends
+    half_edge::vertex_adjacency adjacency{{0, 1, 3, 4}, {1, 0, 2, 1}};
+    std::vector<double> x{0., 5., 1.};
+    std::vector<double> y{0., 0., 0.};
+    const std::vector<std::uint8_t> pinned{1, 0, 1};
+    half_edge::smoothing_options options;
+    options.iterations = 3;
+    options.lambda = 1.;
+    options.threads = 4;
+    half_edge::smooth_coordinates(adjacency, x, y, pinned, options);
+    REQUIRE(x[0] == Catch::Approx(0.));
+    REQUIRE(x[1] == Catch::Approx(0.5));
+    REQUIRE(x[2] == Catch::Approx(1.));
+
+    std::vector<double> too_short{0.};
+    REQUIRE_THROWS_AS(half_edge::smooth_coordinates(adjacency, too_short, y, pinned, options), std::invalid_argument);
+}
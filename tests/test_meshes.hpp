@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Triangulation.hpp"
+#include "triangulation_view.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace half_edge::test {
+
+/**
+ * Builds a regular grid of n x n vertices in [0, n-1]^2, each cell split in two counterclockwise triangles.
+ * @param[in] n The number of vertices per side, at least 2
+ * @return the triangulation of the grid
+ */
+inline Triangulation make_grid(std::size_t n)
+{
+    std::vector<vertex> vertices;
+    vertices.reserve(n * n);
+    for(std::size_t j = 0; j < n; ++j)
+    {
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            vertices.emplace_back(static_cast<double>(i), static_cast<double>(j));
+        }
+    }
+    std::vector<index> faces;
+    faces.reserve(6 * (n - 1) * (n - 1));
+    for(std::size_t j = 0; j + 1 < n; ++j)
+    {
+        for(std::size_t i = 0; i + 1 < n; ++i)
+        {
+            const auto v = j * n + i;
+            faces.insert(faces.end(), {v, v + 1, v + n + 1});
+            faces.insert(faces.end(), {v, v + n + 1, v + n});
+        }
+    }
+    return {std::move(vertices), faces};
+}
+
+/**
+ * Checks the connectivity invariants of every live element of the triangulation.
+ * @param[in] tri The triangulation or read-only view to check
+ * @return true if twins, next/prev links, faces, incident halfedges and border flags are consistent
+ */
+template<triangulation_like M>
+bool is_consistent(const M& tri)
+{
+    std::size_t n_half_edges{0};
+    std::size_t n_faces{0};
+    std::size_t n_vertices{0};
+    for(index e = 0; e < tri.halfEdge_slots(); ++e)
+    {
+        if(!tri.is_halfEdge_alive(e))
+        {
+            continue;
+        }
+        ++n_half_edges;
+        const auto t = tri.twin(e);
+        if(!tri.is_halfEdge_alive(t) || tri.twin(t) != e || tri.origin(tri.next(e)) != tri.origin(t))
+        {
+            return false;
+        }
+        if(tri.next(tri.prev(e)) != e || tri.prev(tri.next(e)) != e)
+        {
+            return false;
+        }
+        if(tri.is_border_face(e) && tri.is_border_face(t))
+        {
+            return false;
+        }
+        if(!tri.is_border_face(e) && (tri.next(e) / 3 != e / 3 || tri.next(tri.next(tri.next(e))) != e))
+        {
+            return false;
+        }
+    }
+    for(index f = 0; f < tri.face_slots(); ++f)
+    {
+        n_faces += tri.is_face_alive(f) ? 1U : 0U;
+    }
+    for(index v = 0; v < tri.vertex_slots(); ++v)
+    {
+        if(!tri.is_vertex_alive(v))
+        {
+            continue;
+        }
+        ++n_vertices;
+        const auto start = tri.edge_of_vertex(v);
+        if(start == INVALID_INDEX)
+        {
+            continue;
+        }
+        if(!tri.is_halfEdge_alive(start) || tri.origin(start) != v)
+        {
+            return false;
+        }
+        bool border{false};
+        auto e = start;
+        do
+        {
+            if(tri.origin(e) != v)
+            {
+                return false;
+            }
+            border = border || tri.is_border_face(e);
+            e = tri.CCW_edge_to_vertex(e);
+        } while(e != start);
+        if(border != tri.is_border_vertex(v))
+        {
+            return false;
+        }
+    }
+    return n_half_edges == tri.halfEdges_size() && n_faces == tri.faces_size() && n_vertices == tri.vertices_size();
+}
+
+}
@@ -0,0 +1,182 @@
+#include "test_meshes.hpp"
+#include "tiling.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using half_edge::index;
+using half_edge::test::is_consistent;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// unique working directory, the discovered test cases and the whole test executable may run concurrently
+fs::path make_directory(const std::string& name)
+{
+    auto directory = fs::temp_directory_path() / (name + "_" + std::to_string(std::random_device{}()));
+    fs::remove_all(directory);
+    return directory;
+}
+
+// writes the n x n grid of make_grid to an OFF file
+fs::path write_grid(const fs::path& directory, std::size_t n, double spacing = 1.)
+{
+    fs::create_directories(directory);
+    const auto path = directory / "grid.off";
+    std::ofstream out(path);
+    out << "OFF\n# grid\n" << n * n << ' ' << 2 * (n - 1) * (n - 1) << " 0\n";
+    for(std::size_t j = 0; j < n; ++j)
+    {
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            // the last vertex stays at (n - 1, n - 1) so that the bounding box does not shrink with the spacing
+            const auto scale = i + 1 == n && j + 1 == n ? 1. : spacing;
+            out << static_cast<double>(i) * scale << ' ' << static_cast<double>(j) * scale << " 0\n";
+        }
+    }
+    for(std::size_t j = 0; j + 1 < n; ++j)
+    {
+        for(std::size_t i = 0; i + 1 < n; ++i)
+        {
+            const auto v = j * n + i;
+            out << "3 " << v << ' ' << v + 1 << ' ' << v + n + 1 << '\n';
+            out << "3 " << v << ' ' << v + n + 1 << ' ' << v + n << '\n';
+        }
+    }
+    return path;
+}
+
+}
+
+TEST_CASE("out-of-core tiling", "[tiling]")
+{
+    const auto directory = make_directory("half_edge_tiling_test");
+    const auto off_file = write_grid(directory, 9);
+
+    half_edge::tiling_options options;
+    // a few faces per sort run, so that the runs are merged, and per tile, so that the grid cells are split
+    options.memory_budget = 2000;
+    options.tiles_per_side = GENERATE(std::size_t{1}, std::size_t{3});
+    const half_edge::tiled_mesh tiles(off_file.string(), directory / "tiles", options);
+    REQUIRE(tiles.vertices_size() == 81);
+    REQUIRE(tiles.faces_size() == 128);
+    REQUIRE(tiles.tiles_per_side() == options.tiles_per_side);
+    REQUIRE(tiles.tile_count() > options.tiles_per_side * options.tiles_per_side);
+
+    std::vector<std::size_t> seen(tiles.faces_size(), 0);
+    std::size_t interior_edges = 0;
+    std::size_t resident = 0;
+    tiles.for_each_tile(
+        [&](const half_edge::mesh_tile& tile)
+        {
+            ++resident;
+            const auto& mesh = tile.mesh;
+            REQUIRE(is_consistent(mesh));
+            REQUIRE(mesh.faces_size() == tiles.tile_faces(tile.id));
+            REQUIRE(std::ranges::is_sorted(tile.vertex_to_global));
+            for(const auto f : tile.face_to_global)
+            {
+                ++seen[f];
+            }
+            for(index e = 0; e < 3 * mesh.faces_size(); ++e)
+            {
+                if(!mesh.is_border_face(mesh.twin(e)))
+                {
+                    ++interior_edges;
+                }
+            }
+            for(const auto& link : tile.links)
+            {
+                REQUIRE(link.tile == tile.id);
+                REQUIRE(link.remote_tile != tile.id);
+                REQUIRE(mesh.is_border_face(mesh.twin(link.half_edge)));
+                const auto remote = tiles.load_tile(link.remote_tile);
+                REQUIRE(remote.vertex_to_global[remote.mesh.origin(link.remote_half_edge)] ==
+                        tile.vertex_to_global[mesh.target(link.half_edge)]);
+                REQUIRE(remote.vertex_to_global[remote.mesh.target(link.remote_half_edge)] ==
+                        tile.vertex_to_global[mesh.origin(link.half_edge)]);
+            }
+        });
+    REQUIRE(resident <= tiles.tile_count());
+    for(const auto count : seen)
+    {
+        REQUIRE(count == 1);
+    }
+    // the 8 x 8 grid has 176 interior edges, counted twice inside the tiles or once in the cross-tile table
+    REQUIRE(interior_edges / 2 + tiles.cross_tile_edges() == 176);
+    REQUIRE(tiles.cross_tile_edges() > 0);
+    fs::remove_all(directory);
+}
+
+TEST_CASE("tiles sized from the memory budget", "[tiling]")
+{
+    const auto directory = make_directory("half_edge_tiling_budget_test");
+    const auto off_file = write_grid(directory, 9);
+
+    half_edge::tiling_options options;
+    options.memory_budget = 16 * 320;
+    const half_edge::tiled_mesh tiles(off_file.string(), directory / "tiles", options);
+    // 128 faces of 320 bytes in tiles of 16 faces on average
+    REQUIRE(tiles.tiles_per_side() == 3);
+    std::size_t faces = 0;
+    for(index t = 0; t < tiles.tile_count(); ++t)
+    {
+        faces += tiles.tile_faces(t);
+    }
+    REQUIRE(faces == 128);
+
+    REQUIRE_THROWS_AS(half_edge::tiled_mesh((directory / "missing.off").string(), directory / "tiles"),
+                      std::invalid_argument);
+    {
+        std::ofstream out(directory / "bad.off");
+        out << "OFF\n3 1 0\n0 0 0\n1 0 0\n0 1 0\n3 0 1 3\n";
+    }
+    REQUIRE_THROWS_AS(half_edge::tiled_mesh((directory / "bad.off").string(), directory / "tiles"),
+                      std::invalid_argument);
+    fs::remove_all(directory);
+}
+
+TEST_CASE("dense cells are split to fit the memory budget", "[tiling]")
+{
+    const auto directory = make_directory("half_edge_tiling_cluster_test");
+    // all the vertices but one in a corner of the first cell of the 3 x 3 grid
+    const auto off_file = write_grid(directory, 9, 1e-3);
+
+    half_edge::tiling_options options;
+    options.memory_budget = 16 * 320;
+    const half_edge::tiled_mesh tiles(off_file.string(), directory / "tiles", options);
+    REQUIRE(tiles.tiles_per_side() == 3);
+    REQUIRE(tiles.tile_count() > 9);
+
+    std::vector<std::size_t> seen(tiles.faces_size(), 0);
+    std::size_t interior_edges = 0;
+    tiles.for_each_tile(
+        [&](const half_edge::mesh_tile& tile)
+        {
+            REQUIRE(tile.mesh.faces_size() <= 16);
+            REQUIRE(is_consistent(tile.mesh));
+            for(const auto f : tile.face_to_global)
+            {
+                ++seen[f];
+            }
+            for(index e = 0; e < 3 * tile.mesh.faces_size(); ++e)
+            {
+                if(!tile.mesh.is_border_face(tile.mesh.twin(e)))
+                {
+                    ++interior_edges;
+                }
+            }
+        });
+    REQUIRE(std::ranges::all_of(seen, [](std::size_t count) { return count == 1; }));
+    REQUIRE(interior_edges / 2 + tiles.cross_tile_edges() == 176);
+    fs::remove_all(directory);
+}
@@ -0,0 +1,446 @@
+#include "Triangulation.hpp"
+#include "test_meshes.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using half_edge::INVALID_INDEX;
+using half_edge::index;
+using half_edge::test::is_consistent;
+using half_edge::test::make_grid;
+
+TEST_CASE("construction from vertices and faces", "[triangulation]")
+{
+    auto tri = make_grid(4);
+    REQUIRE(tri.vertices_size() == 16);
+    REQUIRE(tri.faces_size() == 18);
+    // 27 interior edges counted twice, 12 boundary edges
+    REQUIRE(tri.halfEdges_size() == 2 * 33);
+    REQUIRE(is_consistent(tri));
+    REQUIRE(tri.is_border_vertex(0));
+    REQUIRE_FALSE(tri.is_border_vertex(5));
+    REQUIRE(tri.find_halfedge(0, 1) != INVALID_INDEX);
+    REQUIRE(tri.find_halfedge(0, 15) == INVALID_INDEX);
+
+    REQUIRE_THROWS_AS(half_edge::Triangulation({{0., 0.}, {1., 0.}}, {0, 1}), std::invalid_argument);
+}
+
+TEST_CASE("edge split", "[triangulation][edit]")
+{
+    auto tri = make_grid(3);
+    const auto faces = tri.faces_size();
+    const auto vertices = tri.vertices_size();
+
+    SECTION("interior edge")
+    {
+        const auto e = tri.find_halfedge(0, 4);
+        const auto m = tri.split_edge(e);
+        REQUIRE(tri.vertices_size() == vertices + 1);
+        REQUIRE(tri.faces_size() == faces + 2);
+        REQUIRE(tri.get_PointX(m) == Catch::Approx(0.5));
+        REQUIRE(tri.get_PointY(m) == Catch::Approx(0.5));
+        REQUIRE_FALSE(tri.is_border_vertex(m));
+        REQUIRE(tri.find_halfedge(0, m) != INVALID_INDEX);
+        REQUIRE(tri.find_halfedge(m, 4) != INVALID_INDEX);
+        REQUIRE(tri.find_halfedge(0, 4) == INVALID_INDEX);
+        REQUIRE(is_consistent(tri));
+    }
+
+    SECTION("boundary edge, from either side")
+    {
+        const auto e = GENERATE(true, false);
+        const auto inner = tri.find_halfedge(0, 1);
+        const auto m = tri.split_edge(e ? inner : tri.twin(inner));
+        REQUIRE(tri.vertices_size() == vertices + 1);
+        REQUIRE(tri.faces_size() == faces + 1);
+        REQUIRE(tri.is_border_vertex(m));
+        REQUIRE(is_consistent(tri));
+    }
+}
+
+TEST_CASE("edge collapse", "[triangulation][edit]")
+{
+    SECTION("interior edge")
+    {
+        auto tri = make_grid(4);
+        const auto e = tri.find_halfedge(5, 10);
+        REQUIRE(tri.is_collapse_ok(e));
+        const auto v = tri.collapse_edge(e);
+        REQUIRE(v == 10);
+        REQUIRE_FALSE(tri.is_vertex_alive(5));
+        REQUIRE(tri.vertices_size() == 15);
+        REQUIRE(tri.faces_size() == 16);
+        REQUIRE(is_consistent(tri));
+    }
+
+    SECTION("boundary edge")
+    {
+        auto tri = make_grid(4);
+        const auto e = tri.find_halfedge(1, 2);
+        REQUIRE(tri.is_collapse_ok(e));
+        tri.collapse_edge(e);
+        REQUIRE(tri.faces_size() == 17);
+        REQUIRE(tri.is_border_vertex(2));
+        REQUIRE(is_consistent(tri));
+    }
+
+    SECTION("forbidden collapses")
+    {
+        auto tri = make_grid(4);
+        // interior edge joining two boundary vertices, cutting the corner triangle (2, 3, 7)
+        REQUIRE_FALSE(tri.is_collapse_ok(tri.find_halfedge(2, 7)));
+        REQUIRE_FALSE(tri.is_collapse_ok(tri.find_halfedge(7, 2)));
+        // a rejected collapse keeps the edge index
+        tri.build_edge_index();
+        REQUIRE_THROWS_AS(tri.collapse_edge(tri.find_halfedge(2, 7)), std::invalid_argument);
+        REQUIRE(tri.has_edge_index());
+
+        half_edge::Triangulation single({{0., 0.}, {1., 0.}, {0., 1.}}, {0, 1, 2});
+        REQUIRE_FALSE(single.is_collapse_ok(single.find_halfedge(0, 1)));
+        REQUIRE_THROWS_AS(single.collapse_edge(single.find_halfedge(0, 1)), std::invalid_argument);
+    }
+}
+
+TEST_CASE("face deletion and insertion", "[triangulation][edit]")
+{
+    // faces 2k and 2k+1 split the cell k, face 6 is (4, 5, 8) and face 3 is (1, 5, 4)
+    auto tri = make_grid(3);
+    const auto faces = tri.faces_size();
+    const auto half_edges = tri.halfEdges_size();
+
+    SECTION("face with a boundary edge")
+    {
+        tri.delete_face(6);
+        const auto slots = tri.halfEdge_slots();
+        REQUIRE_FALSE(tri.is_face_alive(6));
+        REQUIRE(tri.faces_size() == faces - 1);
+        REQUIRE(tri.halfEdges_size() == half_edges - 2);
+        REQUIRE(tri.find_halfedge(5, 8) == INVALID_INDEX);
+        REQUIRE(tri.is_border_vertex(4));
+        REQUIRE(is_consistent(tri));
+
+        REQUIRE(tri.add_face(4, 5, 8) == 6);
+        REQUIRE(tri.faces_size() == faces);
+        REQUIRE(tri.halfEdges_size() == half_edges);
+        REQUIRE(tri.halfEdge_slots() == slots);
+        REQUIRE_FALSE(tri.is_border_vertex(4));
+        REQUIRE(is_consistent(tri));
+    }
+
+    SECTION("face with only interior edges")
+    {
+        tri.delete_face(3);
+        REQUIRE(tri.halfEdges_size() == half_edges);
+        REQUIRE(tri.is_border_vertex(4));
+        REQUIRE(is_consistent(tri));
+        REQUIRE(tri.add_face(1, 5, 4) == 3);
+        REQUIRE(tri.halfEdges_size() == half_edges);
+        REQUIRE(is_consistent(tri));
+    }
+
+    SECTION("isolated vertices are removed")
+    {
+        for(index f = 0; f < 8; ++f)
+        {
+            tri.delete_face(f);
+            REQUIRE(is_consistent(tri));
+        }
+        REQUIRE(tri.faces_size() == 0);
+        REQUIRE(tri.vertices_size() == 0);
+        REQUIRE(tri.halfEdges_size() == 0);
+    }
+
+    SECTION("face glued on the boundary")
+    {
+        const auto v = tri.add_vertex(0.5, -1.);
+        REQUIRE(tri.is_vertex_alive(v));
+        const auto f = tri.add_face(0, v, 1);
+        REQUIRE(tri.faces_size() == faces + 1);
+        REQUIRE(tri.halfEdges_size() == half_edges + 4);
+        REQUIRE(tri.twin(tri.find_halfedge(1, 0)) == tri.find_halfedge(0, 1));
+        REQUIRE(tri.find_halfedge(1, 0) / 3 == f);
+        REQUIRE(is_consistent(tri));
+    }
+
+    SECTION("non-manifold faces are rejected")
+    {
+        REQUIRE_THROWS_AS(tri.add_face(0, 1, 4), std::invalid_argument);
+        REQUIRE_THROWS_AS(tri.add_face(4, 2, 6), std::invalid_argument);
+        REQUIRE_THROWS_AS(tri.delete_face(42), std::invalid_argument);
+        REQUIRE(is_consistent(tri));
+    }
+}
+
+TEST_CASE("closing a fan re-links the boundary loops", "[triangulation][edit]")
+{
+    std::vector<half_edge::vertex> vertices{{0., 0.}};
+    for(int k = 0; k < 6; ++k)
+    {
+        vertices.emplace_back(std::cos(k * std::numbers::pi / 3.), std::sin(k * std::numbers::pi / 3.));
+    }
+    half_edge::Triangulation tri(vertices, {0, 1, 2});
+    REQUIRE(is_consistent(tri));
+
+    // three patches meet at the vertex 0 before the gaps between them are filled
+    tri.add_face(0, 3, 4);
+    tri.add_face(0, 5, 6);
+    REQUIRE(is_consistent(tri));
+    tri.add_face(0, 2, 3);
+    REQUIRE(is_consistent(tri));
+    tri.add_face(0, 6, 1);
+    REQUIRE(is_consistent(tri));
+    REQUIRE(tri.is_border_vertex(0));
+    tri.add_face(0, 4, 5);
+    REQUIRE(is_consistent(tri));
+    REQUIRE_FALSE(tri.is_border_vertex(0));
+    REQUIRE(tri.faces_size() == 6);
+    REQUIRE(tri.halfEdges_size() == 24);
+}
+
+TEST_CASE("compaction after edits", "[triangulation][edit]")
+{
+    auto tri = make_grid(5);
+    tri.delete_face(10);
+    tri.split_edge(tri.find_halfedge(6, 12));
+    tri.collapse_edge(tri.find_halfedge(18, 12));
+    tri.delete_face(0);
+    REQUIRE(is_consistent(tri));
+
+    const auto faces = tri.faces_size();
+    const auto vertices = tri.vertices_size();
+    const auto half_edges = tri.halfEdges_size();
+    const auto x = tri.get_PointX(24);
+    const auto map = tri.compact();
+    REQUIRE(tri.faces_size() == faces);
+    REQUIRE(tri.vertex_slots() == vertices);
+    REQUIRE(tri.halfEdge_slots() == half_edges);
+    REQUIRE(map.faces.at(0) == INVALID_INDEX);
+    REQUIRE(map.faces.at(1) == 0);
+    REQUIRE(map.vertices.at(18) == INVALID_INDEX);
+    REQUIRE(map.vertices.at(25) == 24);
+    REQUIRE(tri.get_PointX(map.vertices.at(24)) == Catch::Approx(x));
+    REQUIRE(is_consistent(tri));
+
+    // interior halfedges come first, grouped by face
+    for(index e = 0; e < 3 * faces; ++e)
+    {
+        REQUIRE_FALSE(tri.is_border_face(e));
+    }
+    for(index e = 3 * faces; e < half_edges; ++e)
+    {
+        REQUIRE(tri.is_border_face(e));
+    }
+}
+
+TEST_CASE("random local edits keep the triangulation consistent", "[triangulation][edit]")
+{
+    auto tri = make_grid(8);
+    std::mt19937 gen(42);
+    for(int it = 0; it < 500; ++it)
+    {
+        std::uniform_int_distribution<index> pick(0, tri.halfEdge_slots() - 1);
+        auto e = pick(gen);
+        while(!tri.is_halfEdge_alive(e))
+        {
+            e = pick(gen);
+        }
+        if(it % 3 == 0)
+        {
+            tri.split_edge(e);
+        }
+        else if(tri.is_collapse_ok(e))
+        {
+            tri.collapse_edge(e);
+        }
+        REQUIRE(is_consistent(tri));
+    }
+    tri.compact();
+    REQUIRE(is_consistent(tri));
+}
+
+namespace {
+
+// every live halfedge is the one the edge index returns for its endpoints
+bool edge_index_matches(const half_edge::Triangulation& tri)
+{
+    for(index e = 0; e < tri.halfEdge_slots(); ++e)
+    {
+        if(tri.is_halfEdge_alive(e) && tri.find_halfedge(tri.origin(e), tri.target(e)) != e)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+TEST_CASE("face deltas", "[triangulation][edit]")
+{
+    auto tri = make_grid(6);
+    // the index is opt-in, the construction does not keep one
+    REQUIRE_FALSE(tri.has_edge_index());
+    tri.build_edge_index();
+    REQUIRE(tri.has_edge_index());
+    REQUIRE(edge_index_matches(tri));
+
+    SECTION("removing and adding back faces")
+    {
+        // the faces of the cells (2, 2) and (3, 2), given back with another first vertex
+        const auto added = tri.apply_delta({24, 25, 26, 27}, {15, 21, 14, 14, 21, 20, 22, 15, 16, 21, 15, 22});
+        REQUIRE(added.size() == 4);
+        REQUIRE(tri.faces_size() == 50);
+        REQUIRE(tri.vertices_size() == 36);
+        REQUIRE(is_consistent(tri));
+        REQUIRE(edge_index_matches(tri));
+        REQUIRE_FALSE(tri.is_border_vertex(15));
+        REQUIRE_FALSE(tri.is_border_vertex(21));
+    }
+
+    SECTION("refining a cell around a new vertex")
+    {
+        const auto c = tri.add_vertex(2.5, 2.5);
+        const auto added = tri.apply_delta({24, 25}, {14, 15, c, 15, 21, c, 21, 20, c, 20, 14, c});
+        REQUIRE(added.size() == 4);
+        REQUIRE(tri.faces_size() == 52);
+        REQUIRE(tri.find_halfedge(14, 21) == INVALID_INDEX);
+        REQUIRE(tri.find_halfedge(14, c) != INVALID_INDEX);
+        REQUIRE_FALSE(tri.is_border_vertex(c));
+        REQUIRE(is_consistent(tri));
+        REQUIRE(edge_index_matches(tri));
+    }
+
+    SECTION("vertices left isolated are removed")
+    {
+        tri.apply_delta({0, 1}, {});
+        REQUIRE_FALSE(tri.is_vertex_alive(0));
+        REQUIRE(tri.is_border_vertex(7));
+        REQUIRE(tri.vertices_size() == 35);
+        REQUIRE(is_consistent(tri));
+        REQUIRE(edge_index_matches(tri));
+    }
+
+    SECTION("the index dropped by other edits is rebuilt")
+    {
+        tri.collapse_edge(tri.find_halfedge(14, 15));
+        REQUIRE_FALSE(tri.has_edge_index());
+        const auto f = tri.apply_delta({}, {}).size();
+        REQUIRE(f == 0);
+        REQUIRE(tri.has_edge_index());
+        REQUIRE(edge_index_matches(tri));
+        tri.release_edge_index();
+        REQUIRE(tri.find_halfedge(0, 1) != INVALID_INDEX);
+    }
+
+    SECTION("invalid deltas leave the triangulation untouched")
+    {
+        REQUIRE_THROWS_AS(tri.apply_delta({3, 3}, {}), std::invalid_argument);
+        REQUIRE_THROWS_AS(tri.apply_delta({3}, {0, 1}), std::invalid_argument);
+        REQUIRE_THROWS_AS(tri.apply_delta({3}, {0, 1, 99}), std::invalid_argument);
+        REQUIRE(tri.faces_size() == 50);
+        REQUIRE(is_consistent(tri));
+    }
+
+    SECTION("a rejected added face rolls the delta back")
+    {
+        std::vector<index> before;
+        for(index e = 0; e < 3 * tri.faces_size(); ++e)
+        {
+            before.push_back(tri.origin(e));
+        }
+        // the first added face is valid, the second one is a copy of the face 0
+        REQUIRE_THROWS_AS(tri.apply_delta({24, 25}, {15, 21, 14, tri.origin(0), tri.origin(1), tri.origin(2)}),
+                          std::invalid_argument);
+        REQUIRE(tri.faces_size() == 50);
+        REQUIRE(tri.vertices_size() == 36);
+        for(index e = 0; e < before.size(); ++e)
+        {
+            REQUIRE(tri.origin(e) == before[e]);
+        }
+        REQUIRE(is_consistent(tri));
+        REQUIRE(edge_index_matches(tri));
+    }
+}
+
+TEST_CASE("a face failing in the boundary re-link rolls the delta back", "[triangulation][edit]")
+{
+    std::vector<half_edge::vertex> vertices{{0., 0.}};
+    for(int k = 0; k < 6; ++k)
+    {
+        vertices.emplace_back(std::cos(k * std::numbers::pi / 3.), std::sin(k * std::numbers::pi / 3.));
+    }
+    vertices.insert(vertices.end(), {{0., 3.}, {2., 3.}, {3., 2.}});
+    std::vector<index> fan;
+    for(index k = 0; k < 6; ++k)
+    {
+        fan.insert(fan.end(), {0, 1 + k, 1 + (k + 1) % 6});
+    }
+    half_edge::Triangulation tri(vertices, fan);
+    // the vertex 0 is left with two patches and two gaps
+    tri.delete_face(0);
+    tri.delete_face(3);
+    const auto links = [&tri]()
+    {
+        std::vector<index> out;
+        for(index e = 0; e < tri.halfEdge_slots(); ++e)
+        {
+            if(tri.is_halfEdge_alive(e))
+            {
+                out.insert(out.end(), {e, tri.origin(e), tri.next(e), tri.prev(e), tri.twin(e)});
+            }
+        }
+        return out;
+    };
+    const auto before = links();
+
+    // the last face re-links the patches at the vertex 2 before finding no free gap at the vertex 0
+    REQUIRE_THROWS_AS(tri.apply_delta({}, {2, 4, 7, 2, 8, 9, 4, 2, 0}), std::invalid_argument);
+    REQUIRE(links() == before);
+    REQUIRE(tri.faces_size() == 4);
+    REQUIRE(tri.vertices_size() == 10);
+    REQUIRE(is_consistent(tri));
+    REQUIRE(edge_index_matches(tri));
+
+    // the same face on its own does not change anything either
+    tri.add_face(2, 4, 7);
+    tri.add_face(2, 8, 9);
+    const auto patched = links();
+    REQUIRE_THROWS_AS(tri.add_face(4, 2, 0), std::invalid_argument);
+    REQUIRE(links() == patched);
+}
+
+TEST_CASE("random face deltas keep the edge index consistent", "[triangulation][edit]")
+{
+    auto tri = make_grid(10);
+    std::mt19937 rng(11);
+    for(std::size_t round = 0; round < 30; ++round)
+    {
+        // remove a few faces and put them back
+        std::vector<index> removed;
+        std::vector<index> added;
+        std::uniform_int_distribution<index> pick(0, tri.face_slots() - 1);
+        for(std::size_t k = 0; k < 5; ++k)
+        {
+            const auto f = pick(rng);
+            if(tri.is_face_alive(f) && std::ranges::find(removed, f) == removed.end())
+            {
+                removed.push_back(f);
+                for(std::size_t j = 0; j < 3; ++j)
+                {
+                    added.push_back(tri.origin(3 * f + j));
+                }
+            }
+        }
+        tri.apply_delta(removed, added);
+        REQUIRE(tri.faces_size() == 162);
+        REQUIRE(tri.vertices_size() == 100);
+        REQUIRE(is_consistent(tri));
+        REQUIRE(edge_index_matches(tri));
+    }
+}
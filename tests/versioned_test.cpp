@@ -0,0 +1,173 @@
+#include "adjacency.hpp"
+#include "components.hpp"
+#include "test_meshes.hpp"
+#include "versioned.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using half_edge::index;
+using half_edge::test::is_consistent;
+using half_edge::test::make_grid;
+
+TEST_CASE("snapshots are isolated from the updates", "[versioned]")
+{
+    half_edge::versioned_triangulation mesh(make_grid(4));
+    const auto before = mesh.read();
+    REQUIRE(before.version_number() == 0);
+
+    REQUIRE(mesh.update([](half_edge::Triangulation& tri) { tri.set_point(5, 1.5, 1.25); }) == 1);
+    REQUIRE(mesh.update([](half_edge::Triangulation& tri) { tri.split_edge(tri.find_halfedge(5, 6)); }) == 2);
+    REQUIRE(before.get_PointX(5) == Catch::Approx(1.));
+    REQUIRE(before.vertices_size() == 16);
+    REQUIRE(is_consistent(before));
+
+    const auto after = mesh.read();
+    REQUIRE(after.version_number() == 2);
+    REQUIRE(mesh.version_number() == 2);
+    REQUIRE(after.get_PointX(5) == Catch::Approx(1.5));
+    REQUIRE(after.vertices_size() == 17);
+    REQUIRE(after.faces_size() == before.faces_size() + 2);
+    REQUIRE(is_consistent(after));
+}
+
+TEST_CASE("the algorithms read snapshots", "[versioned]")
+{
+    auto tri = make_grid(6);
+    tri.delete_face(12);
+    half_edge::versioned_triangulation mesh(tri);
+    const auto snapshot = mesh.read();
+    const auto adjacency = half_edge::build_vertex_adjacency(tri);
+    REQUIRE(half_edge::build_vertex_adjacency(snapshot).neighbours == adjacency.neighbours);
+    const auto components = half_edge::label_face_components(snapshot);
+    REQUIRE(components.labels == half_edge::label_face_components(tri).labels);
+    REQUIRE(half_edge::dual_bfs(snapshot, {0}).distances == half_edge::dual_bfs(tri, {0}).distances);
+    REQUIRE(half_edge::extract_component(snapshot, components, 0).faces_size() == tri.faces_size());
+}
+
+TEST_CASE("unchanged chunks are shared and old chunks reclaimed", "[versioned]")
+{
+    // 1600 vertices and more than 9000 halfedges, several chunks each
+    half_edge::versioned_triangulation mesh(make_grid(40));
+    std::weak_ptr<const half_edge::versioned_triangulation::chunk<half_edge::vertex>> old_chunk;
+    {
+        const auto before = mesh.read();
+        REQUIRE(before.data().vertices.size() == 2);
+        old_chunk = before.data().vertices[1];
+        mesh.update([](half_edge::Triangulation& tri) { tri.set_point(1500, 20.25, 37.5); });
+        const auto after = mesh.read();
+        REQUIRE(after.data().vertices[0] == before.data().vertices[0]);
+        REQUIRE(after.data().vertices[1] != before.data().vertices[1]);
+        REQUIRE(after.data().half_edges == before.data().half_edges);
+        // the first snapshot still holds version 0
+        REQUIRE(mesh.retired_versions() == 1);
+        REQUIRE(mesh.reclaim() == 0);
+        REQUIRE_FALSE(old_chunk.expired());
+    }
+    REQUIRE(mesh.reclaim() == 1);
+    REQUIRE(mesh.retired_versions() == 0);
+    REQUIRE(old_chunk.expired());
+}
+
+TEST_CASE("a small edit copies only the chunks it writes", "[versioned]")
+{
+    // 10 vertex chunks and 58 halfedge chunks
+    half_edge::versioned_triangulation mesh(make_grid(100));
+    const auto count_shared = [](const auto& a, const auto& b)
+    {
+        std::size_t shared = 0;
+        for(std::size_t c = 0; c < std::min(a.size(), b.size()); ++c)
+        {
+            if(a[c] == b[c])
+            {
+                ++shared;
+            }
+        }
+        return shared;
+    };
+    const auto before = mesh.read();
+    mesh.update([](half_edge::Triangulation& tri) { tri.delete_face(9801); });
+    const auto after = mesh.read();
+    REQUIRE(is_consistent(after));
+    REQUIRE(after.faces_size() + 1 == before.faces_size());
+    // the face, its neighbours, its vertices and the appended exterior halfedges
+    const auto& vertices = after.data().vertices;
+    const auto& half_edges = after.data().half_edges;
+    REQUIRE(vertices.size() == 10);
+    REQUIRE(half_edges.size() == before.data().half_edges.size());
+    REQUIRE(count_shared(vertices, before.data().vertices) >= vertices.size() - 1);
+    REQUIRE(count_shared(half_edges, before.data().half_edges) >= half_edges.size() - 3);
+
+    // replacing the whole working copy shares nothing
+    mesh.update([](half_edge::Triangulation& tri) { tri = make_grid(100); });
+    const auto replaced = mesh.read();
+    REQUIRE(count_shared(replaced.data().half_edges, half_edges) == 0);
+    REQUIRE(replaced.faces_size() == before.faces_size());
+}
+
+TEST_CASE("readers walk the mesh while a writer edits it", "[versioned]")
+{
+    half_edge::versioned_triangulation mesh(make_grid(12), 8);
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> inconsistent{0};
+    std::atomic<std::size_t> snapshots{0};
+    std::vector<std::jthread> readers;
+    for(std::size_t r = 0; r < 4; ++r)
+    {
+        readers.emplace_back(
+            [&]()
+            {
+                while(!done.load())
+                {
+                    const auto snapshot = mesh.read();
+                    if(!is_consistent(snapshot))
+                    {
+                        ++inconsistent;
+                    }
+                    ++snapshots;
+                }
+            });
+    }
+
+    // let the readers start before the edits
+    while(snapshots.load() == 0)
+    {
+        std::this_thread::yield();
+    }
+    std::mt19937 rng(7);
+    for(std::size_t k = 0; k < 200; ++k)
+    {
+        mesh.update(
+            [&rng](half_edge::Triangulation& tri)
+            {
+                std::uniform_int_distribution<index> pick(0, tri.halfEdge_slots() - 1);
+                auto e = pick(rng);
+                while(!tri.is_halfEdge_alive(e))
+                {
+                    e = pick(rng);
+                }
+                if(tri.is_collapse_ok(e) && tri.faces_size() > 100)
+                {
+                    tri.collapse_edge(e);
+                }
+                else
+                {
+                    tri.split_edge(e);
+                }
+            });
+    }
+    done = true;
+    readers.clear();
+    REQUIRE(inconsistent == 0);
+    REQUIRE(snapshots > 0);
+    REQUIRE(mesh.version_number() == 200);
+    mesh.reclaim();
+    REQUIRE(mesh.retired_versions() == 0);
+}
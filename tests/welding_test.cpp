@@ -0,0 +1,113 @@
+#include "welding.hpp"
+#include "test_meshes.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using half_edge::index;
+using half_edge::vertex;
+using half_edge::test::is_consistent;
+using half_edge::test::make_grid;
+
+namespace {
+
+// every triangle of an n x n grid with its own copies of the vertices, moved by less than jitter
+void make_soup(std::size_t n, double jitter, std::vector<vertex>& vertices, std::vector<index>& faces)
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> noise(-jitter, jitter);
+    const auto grid = make_grid(n);
+    for(index f = 0; f < grid.faces_size(); ++f)
+    {
+        auto h = 3 * f;
+        for(int k = 0; k < 3; ++k)
+        {
+            const auto v = grid.origin(h);
+            faces.push_back(vertices.size());
+            vertices.emplace_back(grid.get_PointX(v) + noise(rng), grid.get_PointY(v) + noise(rng));
+            h = grid.next(h);
+        }
+    }
+}
+
+}
+
+TEST_CASE("weld a triangle soup back into a grid", "[welding]")
+{
+    // large enough for the radix sort
+    constexpr std::size_t n = 110;
+    std::vector<vertex> vertices;
+    std::vector<index> faces;
+    make_soup(n, 1e-10, vertices, faces);
+    const auto n_faces = faces.size() / 3;
+    REQUIRE(vertices.size() > 65536);
+
+    half_edge::welding_options options;
+    options.threads = 4;
+    const auto result = half_edge::weld_vertices(vertices, faces, options);
+    REQUIRE(vertices.size() == n * n);
+    REQUIRE(result.merged_vertices == 3 * n_faces - n * n);
+    REQUIRE(result.dropped_faces == 0);
+    REQUIRE(faces.size() == 3 * n_faces);
+    REQUIRE(result.vertex_map[faces.size() - 1] < vertices.size());
+
+    const half_edge::Triangulation tri(std::move(vertices), faces);
+    REQUIRE(is_consistent(tri));
+    REQUIRE(tri.vertices_size() == n * n);
+}
+
+TEST_CASE("welding compares neighbouring cells", "[welding]")
+{
+    // 0.999 and 1.001 straddle a cell border, 0.5 is too far from both
+    std::vector<vertex> vertices{{0.999, 0.}, {0.5, 0.}, {1.001, 0.0005}, {3., 3.}, {0., 0.}};
+    std::vector<index> faces{0, 1, 3, 2, 1, 3, 0, 2, 4};
+    half_edge::welding_options options;
+    options.epsilon = 0.01;
+    const auto result = half_edge::weld_vertices(vertices, faces, options);
+    REQUIRE(std::ranges::equal(result.vertex_map, std::vector<index>{0, 1, 0, 2, 3}));
+    REQUIRE(vertices.size() == 4);
+    REQUIRE(vertices[0].x == Catch::Approx(0.999));
+    // the first two faces are now the same triangle, the last one is degenerate
+    REQUIRE(result.dropped_faces == 1);
+    REQUIRE(faces == std::vector<index>{0, 1, 2, 0, 1, 2});
+}
+
+TEST_CASE("welding with a distance finer than the grid", "[welding]")
+{
+    // the cells are coarser than epsilon, the vertices of a cell are compared one by one
+    std::vector<vertex> vertices{{0., 0.}, {1e-12, 0.}, {1e-12 + 1e-300, 0.}, {1., 1.}};
+    std::vector<index> faces{0, 1, 3, 1, 2, 3};
+    half_edge::welding_options options;
+    options.epsilon = 1e-290;
+    const auto result = half_edge::weld_vertices(vertices, faces, options);
+    REQUIRE(std::ranges::equal(result.vertex_map, std::vector<index>{0, 1, 1, 2}));
+    REQUIRE(result.dropped_faces == 1);
+    REQUIRE(faces == std::vector<index>{0, 1, 2});
+}
+
+TEST_CASE("OFF files are welded on load", "[welding]")
+{
+    const auto path = std::filesystem::temp_directory_path() / "he_welding_test.off";
+    {
+        // two triangles sharing an edge, written with separate vertices
+        std::ofstream out(path);
+        out << "OFF\n6 2 0\n0 0 0\n1 0 0\n1 1 0\n0 0 0\n1 1 0\n0 1 0\n3 0 1 2\n3 3 4 5\n";
+    }
+    const half_edge::Triangulation welded(path.string());
+    REQUIRE(welded.vertices_size() == 4);
+    REQUIRE(welded.faces_size() == 2);
+    REQUIRE(is_consistent(welded));
+
+    half_edge::welding_options options;
+    options.enabled = false;
+    const half_edge::Triangulation raw(path.string(), options);
+    REQUIRE(raw.vertices_size() == 6);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,105 @@
+#include "thread_pool.hpp"
+#include "parallel.hpp"
+
+#include <limits>
+
+namespace half_edge {
+
+namespace {
+
+// the pool and the index of the worker running on this thread, if any
+thread_local const thread_pool* current_pool{nullptr};
+thread_local std::size_t current_worker{0};
+
+}
+
+thread_pool::thread_pool(std::size_t threads)
+{
+    const auto n = resolve_threads(threads, std::numeric_limits<std::size_t>::max());
+    m_queues.reserve(n);
+    for(std::size_t k = 0; k < n; ++k)
+    {
+        m_queues.push_back(std::make_unique<task_queue>());
+    }
+    m_workers.reserve(n);
+    for(std::size_t k = 0; k < n; ++k)
+    {
+        m_workers.emplace_back([this, k] { run(k); });
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        const std::scoped_lock lock(m_wait_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    m_workers.clear();
+}
+
+void thread_pool::submit(std::function<void()> task)
+{
+    const auto k = current_pool == this ? current_worker
+                                        : m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    {
+        const std::scoped_lock lock(m_queues[k]->mutex);
+        m_queues[k]->tasks.push_back(std::move(task));
+    }
+    {
+        const std::scoped_lock lock(m_wait_mutex);
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_wake.notify_one();
+}
+
+bool thread_pool::try_pop(std::size_t worker, std::function<void()>& task)
+{
+    {
+        auto& own = *m_queues[worker];
+        const std::scoped_lock lock(own.mutex);
+        if(!own.tasks.empty())
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for(std::size_t k = 1; k < m_queues.size(); ++k)
+    {
+        auto& victim = *m_queues[(worker + k) % m_queues.size()];
+        const std::scoped_lock lock(victim.mutex);
+        if(!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void thread_pool::run(std::size_t worker)
+{
+    current_pool = this;
+    current_worker = worker;
+    std::function<void()> task;
+    while(true)
+    {
+        if(try_pop(worker, task))
+        {
+            m_pending.fetch_sub(1, std::memory_order_relaxed);
+            task();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock lock(m_wait_mutex);
+        m_wake.wait(lock, [this] { return m_pending.load(std::memory_order_relaxed) > 0 || m_stopping; });
+        if(m_stopping && m_pending.load(std::memory_order_relaxed) == 0)
+        {
+            return;
+        }
+    }
+}
+
+}
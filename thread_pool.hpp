@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace half_edge {
+
+/**
+ * Fixed set of worker threads with one task deque each. A worker runs the newest task of its own deque and steals
+ * the oldest task of another deque when its own is empty. Tasks submitted from a worker go to its deque, the
+ * others are spread round-robin.
+ */
+class thread_pool
+{
+  public:
+    /**
+     * Starts the workers.
+     * @param[in] threads The number of workers, 0 for the hardware concurrency
+     */
+    explicit thread_pool(std::size_t threads = 0);
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+    // runs the tasks still queued, then joins the workers
+    ~thread_pool();
+
+    /**
+     * Queues a task, it must not throw.
+     * @param[in] task The task
+     */
+    void submit(std::function<void()> task);
+
+    [[nodiscard]] std::size_t size() const { return m_queues.size(); }
+
+  private:
+    struct task_queue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    bool try_pop(std::size_t worker, std::function<void()>& task);
+    void run(std::size_t worker);
+
+    std::vector<std::unique_ptr<task_queue>> m_queues;
+    /// number of queued tasks, increased under m_wait_mutex so that no wake-up is lost
+    std::atomic<std::size_t> m_pending{0};
+    std::atomic<std::size_t> m_next_queue{0};
+    std::mutex m_wait_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping{false};
+    std::vector<std::jthread> m_workers;
+};
+
+}
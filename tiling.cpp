@@ -0,0 +1,731 @@
+#include "tiling.hpp"
+#include "model_io.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace half_edge {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr auto VERTICES_FILE{"vertices.bin"};
+constexpr auto FACES_FILE{"faces.bin"};
+constexpr auto VERTEX_FACES_FILE{"vertex_faces.bin"};
+constexpr auto TILE_VERTICES_FILE{"tile_vertices.bin"};
+constexpr auto BORDERS_FILE{"borders.bin"};
+constexpr auto LINKS_FILE{"links.bin"};
+/// estimated peak footprint of one face during the construction of a tile: halfedges, vertices and edge map
+constexpr std::size_t BYTES_PER_FACE = 320;
+
+struct face_record
+{
+    index tile{};
+    index face{};
+    std::array<index, 3> vertices{};
+};
+
+struct vertex_record
+{
+    index global{};
+    double x{};
+    double y{};
+};
+
+// a vertex used by a face of the tile
+struct tile_vertex_record
+{
+    index tile{};
+    vertex_record vertex{};
+};
+
+// the number of faces whose first vertex is the vertex
+struct vertex_faces_record
+{
+    index vertex{};
+    index faces{};
+};
+
+// an interior halfedge of a tile without twin in the tile, keyed by its undirected edge
+struct border_record
+{
+    index low{};
+    index high{};
+    index tile{};
+    index half_edge{};
+};
+
+std::ofstream open_output(const fs::path& path)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if(!out.is_open())
+    {
+        throw std::runtime_error("unable to write " + path.string());
+    }
+    return out;
+}
+
+std::ifstream open_input(const fs::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if(!in.is_open())
+    {
+        throw std::runtime_error("unable to read " + path.string());
+    }
+    return in;
+}
+
+template<class T>
+void write_records(std::ostream& out, const T* records, std::size_t count)
+{
+    out.write(reinterpret_cast<const char*>(records), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+// read up to count records, returns the number of records read
+template<class T>
+std::size_t read_records(std::istream& in, T* records, std::size_t count)
+{
+    in.read(reinterpret_cast<char*>(records), static_cast<std::streamsize>(count * sizeof(T)));
+    return static_cast<std::size_t>(in.gcount()) / sizeof(T);
+}
+
+template<class T>
+std::vector<T> read_range(const fs::path& path, std::size_t offset, std::size_t count)
+{
+    auto in = open_input(path);
+    in.seekg(static_cast<std::streamoff>(offset * sizeof(T)));
+    std::vector<T> records(count);
+    if(read_records(in, records.data(), count) != count)
+    {
+        throw std::runtime_error("truncated file " + path.string());
+    }
+    return records;
+}
+
+// sort the records of the file in place with sorted runs of at most budget bytes and a k-way merge
+template<class T, class Less>
+void external_sort(const fs::path& path, std::size_t budget, Less less)
+{
+    const auto chunk = std::max<std::size_t>(1, budget / sizeof(T));
+    std::vector<fs::path> runs;
+    {
+        auto in = open_input(path);
+        std::vector<T> buffer(std::min(chunk, static_cast<std::size_t>(fs::file_size(path)) / sizeof(T) + 1));
+        while(const auto n = read_records(in, buffer.data(), buffer.size()))
+        {
+            std::sort(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(n), less);
+            runs.push_back(path.string() + ".run" + std::to_string(runs.size()));
+            auto out = open_output(runs.back());
+            write_records(out, buffer.data(), n);
+        }
+    }
+    if(runs.size() <= 1)
+    {
+        if(!runs.empty())
+        {
+            fs::rename(runs.front(), path);
+        }
+        return;
+    }
+
+    std::vector<std::ifstream> inputs;
+    inputs.reserve(runs.size());
+    using head = std::pair<T, std::size_t>;
+    // ties are broken by run so that the merge is stable
+    auto later = [&less](const head& a, const head& b)
+    { return less(b.first, a.first) || (!less(a.first, b.first) && b.second < a.second); };
+    std::priority_queue<head, std::vector<head>, decltype(later)> heads(later);
+    for(std::size_t k = 0; k < runs.size(); ++k)
+    {
+        inputs.push_back(open_input(runs[k]));
+        T record{};
+        if(read_records(inputs.back(), &record, 1) == 1)
+        {
+            heads.emplace(record, k);
+        }
+    }
+    {
+        auto out = open_output(path);
+        while(!heads.empty())
+        {
+            auto [record, k] = heads.top();
+            heads.pop();
+            write_records(out, &record, 1);
+            if(read_records(inputs[k], &record, 1) == 1)
+            {
+                heads.emplace(record, k);
+            }
+        }
+    }
+    inputs.clear();
+    for(const auto& run : runs)
+    {
+        fs::remove(run);
+    }
+}
+
+Triangulation build_tile_mesh(const std::vector<face_record>& faces, const std::vector<vertex_record>& vertices)
+{
+    std::vector<vertex> local_vertices;
+    local_vertices.reserve(vertices.size());
+    for(const auto& v : vertices)
+    {
+        local_vertices.emplace_back(v.x, v.y);
+    }
+    std::vector<index> local_faces;
+    local_faces.reserve(3 * faces.size());
+    for(const auto& f : faces)
+    {
+        for(const auto v : f.vertices)
+        {
+            const auto it = std::ranges::lower_bound(vertices, v, {}, &vertex_record::global);
+            local_faces.push_back(static_cast<index>(it - vertices.begin()));
+        }
+    }
+    return {std::move(local_vertices), local_faces};
+}
+
+// parse a face line of an OFF file, "3 v0 v1 v2" as read by Triangulation::read_OFFfile
+std::array<index, 3> parse_off_face(const std::string& line)
+{
+    std::string_view text = line;
+    long long length{0};
+    if(!parse_next(text, length) || length != 3)
+    {
+        throw std::invalid_argument("only triangles are supported: " + line);
+    }
+    std::array<index, 3> face{};
+    for(auto& vertex_idx : face)
+    {
+        long long tmp{0};
+        if(!parse_next(text, tmp) || tmp < 0)
+        {
+            throw std::invalid_argument("failed to parse the faces: " + line);
+        }
+        vertex_idx = static_cast<index>(tmp);
+    }
+    return face;
+}
+
+// calls f(record) on the records of the file, read in blocks of the budget
+template<class T, class F>
+void for_each_record(const fs::path& path, std::size_t budget, F&& f)
+{
+    auto in = open_input(path);
+    std::vector<T> buffer(std::max<std::size_t>(1, budget / sizeof(T)));
+    while(const auto n = read_records(in, buffer.data(), buffer.size()))
+    {
+        for(std::size_t k = 0; k < n; ++k)
+        {
+            f(buffer[k]);
+        }
+    }
+}
+
+// reads the points of the vertices file in blocks of the budget, for vertices queried in increasing order
+class point_cursor
+{
+  public:
+    point_cursor(const fs::path& path, std::size_t budget)
+        : m_in(open_input(path)), m_buffer(std::max<std::size_t>(1, budget / sizeof(std::array<double, 2>)))
+    {
+    }
+
+    const std::array<double, 2>& at(index v)
+    {
+        while(v >= m_first + m_size)
+        {
+            m_first += m_size;
+            m_size = read_records(m_in, m_buffer.data(), m_buffer.size());
+            if(m_size == 0)
+            {
+                throw std::runtime_error("truncated vertices file");
+            }
+        }
+        return m_buffer[v - m_first];
+    }
+
+  private:
+    std::ifstream m_in;
+    std::vector<std::array<double, 2>> m_buffer;
+    /// vertex of the first point of the buffer
+    index m_first{0};
+    std::size_t m_size{0};
+};
+
+/// depth at which a cell over the budget is no longer split, its faces share at most a few vertices
+constexpr std::size_t MAX_SPLIT_DEPTH = 20;
+
+// the cells of a grid of side x side tiles over the bounding box, each of them split in quadrants recursively while
+// the faces whose first vertex lies in it do not fit in the budget; the leaves are the tiles
+class cell_tree
+{
+  public:
+    cell_tree(std::size_t side, std::array<double, 2> low, std::array<double, 2> high)
+        : m_side(side), m_low(low), m_high(high)
+    {
+        m_nodes.resize(side * side);
+        for(std::size_t k = 0; k < m_nodes.size(); ++k)
+        {
+            m_nodes[k].ix = k % side;
+            m_nodes[k].iy = k / side;
+        }
+    }
+
+    // counts the faces of a vertex in the leaf holding its point
+    void count(const std::array<double, 2>& point, std::size_t faces)
+    {
+        const auto position = grid_position(point);
+        auto& node = m_nodes[leaf(position)];
+        node.faces += faces;
+        for(std::size_t c = 0; c < 2; ++c)
+        {
+            node.low[c] = std::min(node.low[c], position[c]);
+            node.high[c] = std::max(node.high[c], position[c]);
+        }
+    }
+
+    // splits the leaves holding more than max_faces faces and resets the counts
+    // Output: true if a leaf was split
+    bool split(std::size_t max_faces)
+    {
+        bool split = false;
+        const auto n_nodes = m_nodes.size();
+        for(std::size_t k = 0; k < n_nodes; ++k)
+        {
+            auto node = m_nodes[k];
+            m_nodes[k].faces = 0;
+            m_nodes[k].low = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+            m_nodes[k].high = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+            // a leaf whose points all coincide keeps its faces together at any depth
+            if(node.children != 0 || node.faces <= max_faces || node.depth == MAX_SPLIT_DEPTH ||
+               (node.high[0] <= node.low[0] && node.high[1] <= node.low[1]))
+            {
+                continue;
+            }
+            m_nodes[k].children = m_nodes.size();
+            for(std::size_t q = 0; q < 4; ++q)
+            {
+                auto& child = m_nodes.emplace_back();
+                child.depth = node.depth + 1;
+                child.ix = 2 * node.ix + q % 2;
+                child.iy = 2 * node.iy + q / 2;
+            }
+            split = true;
+        }
+        return split;
+    }
+
+    // numbers the leaves, grid cells in row order and quadrants depth first
+    // Output: the number of tiles
+    std::size_t number_leaves()
+    {
+        std::size_t tiles = 0;
+        for(std::size_t k = 0; k < m_side * m_side; ++k)
+        {
+            number_leaves(k, tiles);
+        }
+        return tiles;
+    }
+
+    [[nodiscard]] std::uint32_t tile(const std::array<double, 2>& point) const
+    {
+        return m_nodes[leaf(grid_position(point))].tile;
+    }
+
+  private:
+    struct cell_node
+    {
+        std::size_t depth{0};
+        std::size_t ix{0};
+        std::size_t iy{0};
+        /// first of the 4 quadrants, 0 for a leaf
+        std::size_t children{0};
+        std::size_t faces{0};
+        /// extent of the counted points in grid coordinates
+        std::array<double, 2> low{std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+        std::array<double, 2> high{std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+        std::uint32_t tile{0};
+    };
+
+    [[nodiscard]] std::array<double, 2> grid_position(const std::array<double, 2>& point) const
+    {
+        std::array<double, 2> position{};
+        for(std::size_t c = 0; c < 2; ++c)
+        {
+            position[c] = m_high[c] <= m_low[c]
+                              ? 0.
+                              : (point[c] - m_low[c]) / (m_high[c] - m_low[c]) * static_cast<double>(m_side);
+        }
+        return position;
+    }
+
+    [[nodiscard]] std::size_t cell(double position, std::size_t depth) const
+    {
+        const auto cells = m_side << depth;
+        return std::min(static_cast<std::size_t>(position * static_cast<double>(std::size_t{1} << depth)), cells - 1);
+    }
+
+    [[nodiscard]] std::size_t leaf(const std::array<double, 2>& position) const
+    {
+        auto k = cell(position[1], 0) * m_side + cell(position[0], 0);
+        while(m_nodes[k].children != 0)
+        {
+            const auto& parent = m_nodes[k];
+            const auto ix = cell(position[0], parent.depth + 1) - 2 * parent.ix;
+            const auto iy = cell(position[1], parent.depth + 1) - 2 * parent.iy;
+            k = parent.children + 2 * iy + ix;
+        }
+        return k;
+    }
+
+    void number_leaves(std::size_t k, std::size_t& tiles)
+    {
+        if(m_nodes[k].children == 0)
+        {
+            m_nodes[k].tile = static_cast<std::uint32_t>(tiles++);
+            return;
+        }
+        for(std::size_t q = 0; q < 4; ++q)
+        {
+            number_leaves(m_nodes[k].children + q, tiles);
+        }
+    }
+
+    std::size_t m_side;
+    std::array<double, 2> m_low;
+    std::array<double, 2> m_high;
+    std::vector<cell_node> m_nodes{};
+};
+
+std::vector<std::size_t> offsets_from_counts(const std::vector<std::size_t>& counts)
+{
+    std::vector<std::size_t> offsets(counts.size() + 1, 0);
+    std::inclusive_scan(counts.begin(), counts.end(), offsets.begin() + 1);
+    return offsets;
+}
+
+}
+
+tiled_mesh::tiled_mesh(const std::string& OFF_file, fs::path directory, const tiling_options& options)
+    : m_directory(std::move(directory))
+{
+    fs::create_directories(m_directory);
+    std::ifstream off_file(OFF_file);
+    if(!off_file.is_open())
+    {
+        throw std::invalid_argument("unable to open file " + OFF_file);
+    }
+    if(!has_valid_off_header(off_file))
+    {
+        throw std::invalid_argument("The file is not an OFF file");
+    }
+    std::tie(n_vertices, n_faces) = parse_num_vertex_face(off_file);
+
+    // spill the vertices to disk while computing the bounding box
+    auto min_x = std::numeric_limits<double>::max();
+    auto min_y = std::numeric_limits<double>::max();
+    auto max_x = std::numeric_limits<double>::lowest();
+    auto max_y = std::numeric_limits<double>::lowest();
+    std::string line;
+    {
+        auto out = open_output(m_directory / VERTICES_FILE);
+        index idx{0};
+        while(idx < n_vertices && std::getline(off_file, line))
+        {
+            if(is_line_to_skip(line))
+            {
+                continue;
+            }
+            std::array<double, 2> point{};
+            std::string_view text = line;
+            if(!parse_next(text, point[0]) || !parse_next(text, point[1]))
+            {
+                throw std::invalid_argument("failed to parse the vertices");
+            }
+            min_x = std::min(min_x, point[0]);
+            min_y = std::min(min_y, point[1]);
+            max_x = std::max(max_x, point[0]);
+            max_y = std::max(max_y, point[1]);
+            write_records(out, &point, 1);
+            ++idx;
+        }
+        if(idx < n_vertices)
+        {
+            throw std::invalid_argument("missing vertices");
+        }
+    }
+
+    // square grid of tiles, sized so that an average tile fits in the budget
+    const auto budget = std::max<std::size_t>(options.memory_budget, BYTES_PER_FACE);
+    if(options.tiles_per_side > 0)
+    {
+        m_tiles_per_side = options.tiles_per_side;
+    }
+    else
+    {
+        const auto tiles = (n_faces * BYTES_PER_FACE + budget - 1) / budget;
+        m_tiles_per_side = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(tiles))));
+    }
+    const auto side = m_tiles_per_side;
+    if(side * side > std::numeric_limits<std::uint32_t>::max())
+    {
+        throw std::invalid_argument("too many tiles");
+    }
+
+    // spill the faces in one pass over the rest of the file
+    {
+        auto out = open_output(m_directory / FACES_FILE);
+        index f{0};
+        while(f < n_faces && std::getline(off_file, line))
+        {
+            if(is_line_to_skip(line))
+            {
+                continue;
+            }
+            const face_record record{0, f, parse_off_face(line)};
+            if(std::ranges::any_of(record.vertices, [this](index v) { return v >= n_vertices; }))
+            {
+                throw std::invalid_argument("face index out of range: " + line);
+            }
+            write_records(out, &record, 1);
+            ++f;
+        }
+        if(f < n_faces)
+        {
+            throw std::invalid_argument("missing faces");
+        }
+    }
+    off_file.close();
+
+    // sorted by first vertex, the faces give the face counts of the vertices and are joined with the points in
+    // vertex order, nothing is kept per vertex
+    external_sort<face_record>(m_directory / FACES_FILE,
+                               budget,
+                               [](const face_record& a, const face_record& b)
+                               { return std::tie(a.vertices[0], a.face) < std::tie(b.vertices[0], b.face); });
+    {
+        auto out = open_output(m_directory / VERTEX_FACES_FILE);
+        vertex_faces_record current{};
+        for_each_record<face_record>(m_directory / FACES_FILE,
+                                     budget,
+                                     [&](const face_record& face)
+                                     {
+                                         if(current.faces > 0 && current.vertex != face.vertices[0])
+                                         {
+                                             write_records(out, &current, 1);
+                                             current.faces = 0;
+                                         }
+                                         current.vertex = face.vertices[0];
+                                         ++current.faces;
+                                     });
+        if(current.faces > 0)
+        {
+            write_records(out, &current, 1);
+        }
+    }
+
+    // split the grid cells over the budget, one pass over the counted vertices per level
+    cell_tree cells(side, {min_x, min_y}, {max_x, max_y});
+    do
+    {
+        point_cursor points(m_directory / VERTICES_FILE, budget);
+        for_each_record<vertex_faces_record>(m_directory / VERTEX_FACES_FILE,
+                                             budget,
+                                             [&](const vertex_faces_record& record)
+                                             { cells.count(points.at(record.vertex), record.faces); });
+    } while(cells.split(budget / BYTES_PER_FACE));
+    fs::remove(m_directory / VERTEX_FACES_FILE);
+    const auto n_tiles = cells.number_leaves();
+    if(n_tiles > std::numeric_limits<std::uint32_t>::max())
+    {
+        throw std::invalid_argument("too many tiles");
+    }
+
+    // the faces take the tile of their first vertex, then they are bucketed by tile
+    std::vector<std::size_t> face_counts(n_tiles, 0);
+    {
+        const auto untiled = m_directory / (std::string(FACES_FILE) + ".untiled");
+        fs::rename(m_directory / FACES_FILE, untiled);
+        {
+            auto out = open_output(m_directory / FACES_FILE);
+            point_cursor points(m_directory / VERTICES_FILE, budget);
+            for_each_record<face_record>(untiled,
+                                         budget,
+                                         [&](face_record face)
+                                         {
+                                             face.tile = cells.tile(points.at(face.vertices[0]));
+                                             ++face_counts[face.tile];
+                                             write_records(out, &face, 1);
+                                         });
+        }
+        fs::remove(untiled);
+    }
+    external_sort<face_record>(m_directory / FACES_FILE,
+                               budget,
+                               [](const face_record& a, const face_record& b)
+                               { return std::tie(a.tile, a.face) < std::tie(b.tile, b.face); });
+    m_face_offsets = offsets_from_counts(face_counts);
+
+    // the vertices of every tile: the pairs (vertex, tile) of the faces sorted by vertex are joined with the points in
+    // one sequential pass, then sorted back by tile
+    const auto unsorted = m_directory / (std::string(TILE_VERTICES_FILE) + ".unsorted");
+    {
+        auto out = open_output(unsorted);
+        for_each_record<face_record>(m_directory / FACES_FILE,
+                                     budget,
+                                     [&](const face_record& face)
+                                     {
+                                         for(const auto v : face.vertices)
+                                         {
+                                             const tile_vertex_record record{face.tile, {v, 0., 0.}};
+                                             write_records(out, &record, 1);
+                                         }
+                                     });
+    }
+    const auto by_vertex = [](const tile_vertex_record& a, const tile_vertex_record& b)
+    { return std::tie(a.vertex.global, a.tile) < std::tie(b.vertex.global, b.tile); };
+    const auto by_tile = [](const tile_vertex_record& a, const tile_vertex_record& b)
+    { return std::tie(a.tile, a.vertex.global) < std::tie(b.tile, b.vertex.global); };
+    external_sort<tile_vertex_record>(unsorted, budget, by_vertex);
+    const auto joined = m_directory / (std::string(TILE_VERTICES_FILE) + ".joined");
+    {
+        auto out = open_output(joined);
+        point_cursor points(m_directory / VERTICES_FILE, budget);
+        std::optional<tile_vertex_record> last{};
+        for_each_record<tile_vertex_record>(unsorted,
+                                            budget,
+                                            [&](tile_vertex_record record)
+                                            {
+                                                // a vertex is listed once per face of the tile
+                                                if(last && !by_vertex(*last, record))
+                                                {
+                                                    return;
+                                                }
+                                                const auto& point = points.at(record.vertex.global);
+                                                record.vertex.x = point[0];
+                                                record.vertex.y = point[1];
+                                                write_records(out, &record, 1);
+                                                last = record;
+                                            });
+    }
+    fs::remove(unsorted);
+    external_sort<tile_vertex_record>(joined, budget, by_tile);
+    std::vector<std::size_t> vertex_counts(n_tiles, 0);
+    {
+        auto out = open_output(m_directory / TILE_VERTICES_FILE);
+        for_each_record<tile_vertex_record>(joined,
+                                            budget,
+                                            [&](const tile_vertex_record& record)
+                                            {
+                                                write_records(out, &record.vertex, 1);
+                                                ++vertex_counts[record.tile];
+                                            });
+    }
+    fs::remove(joined);
+    m_vertex_offsets = offsets_from_counts(vertex_counts);
+
+    // build every tile once to record its border, its faces and vertices are read in sequence
+    {
+        auto faces_in = open_input(m_directory / FACES_FILE);
+        auto vertices_in = open_input(m_directory / TILE_VERTICES_FILE);
+        auto borders_out = open_output(m_directory / BORDERS_FILE);
+        for(index t = 0; t < n_tiles; ++t)
+        {
+            std::vector<face_record> faces(face_counts[t]);
+            std::vector<vertex_record> vertices(vertex_counts[t]);
+            if(read_records(faces_in, faces.data(), faces.size()) != faces.size() ||
+               read_records(vertices_in, vertices.data(), vertices.size()) != vertices.size())
+            {
+                throw std::runtime_error("truncated tile files");
+            }
+
+            const auto mesh = build_tile_mesh(faces, vertices);
+            for(auto e = 3 * mesh.faces_size(); e < mesh.halfEdge_slots(); ++e)
+            {
+                const auto h = mesh.twin(e);
+                const auto a = vertices[mesh.origin(h)].global;
+                const auto b = vertices[mesh.target(h)].global;
+                const border_record record{std::min(a, b), std::max(a, b), t, h};
+                write_records(borders_out, &record, 1);
+            }
+        }
+    }
+
+    // halfedges of two tiles sharing an edge follow each other once sorted, the others are on the mesh boundary
+    external_sort<border_record>(
+        m_directory / BORDERS_FILE,
+        budget,
+        [](const border_record& a, const border_record& b)
+        { return std::tie(a.low, a.high, a.tile, a.half_edge) < std::tie(b.low, b.high, b.tile, b.half_edge); });
+    std::vector<std::size_t> link_counts(n_tiles, 0);
+    {
+        auto in = open_input(m_directory / BORDERS_FILE);
+        auto out = open_output(m_directory / LINKS_FILE);
+        std::vector<border_record> group;
+        border_record record{};
+        auto flush = [&]()
+        {
+            // non-manifold edges shared by more than two faces are left unlinked
+            if(group.size() == 2 && group[0].tile != group[1].tile)
+            {
+                const std::array<tile_link, 2> links{
+                    tile_link{group[0].tile, group[0].half_edge, group[1].tile, group[1].half_edge},
+                    tile_link{group[1].tile, group[1].half_edge, group[0].tile, group[0].half_edge}};
+                write_records(out, links.data(), links.size());
+                ++link_counts[group[0].tile];
+                ++link_counts[group[1].tile];
+            }
+            group.clear();
+        };
+        while(read_records(in, &record, 1) == 1)
+        {
+            if(!group.empty() && (group.front().low != record.low || group.front().high != record.high))
+            {
+                flush();
+            }
+            group.push_back(record);
+        }
+        flush();
+    }
+    fs::remove(m_directory / BORDERS_FILE);
+    external_sort<tile_link>(m_directory / LINKS_FILE,
+                             budget,
+                             [](const tile_link& a, const tile_link& b)
+                             { return std::tie(a.tile, a.half_edge) < std::tie(b.tile, b.half_edge); });
+    m_link_offsets = offsets_from_counts(link_counts);
+}
+
+mesh_tile tiled_mesh::load_tile(index t) const
+{
+    const auto faces = read_range<face_record>(m_directory / FACES_FILE, m_face_offsets.at(t), tile_faces(t));
+    const auto vertices = read_range<vertex_record>(
+        m_directory / TILE_VERTICES_FILE, m_vertex_offsets[t], m_vertex_offsets[t + 1] - m_vertex_offsets[t]);
+    mesh_tile tile{t, build_tile_mesh(faces, vertices)};
+    tile.vertex_to_global.reserve(vertices.size());
+    for(const auto& v : vertices)
+    {
+        tile.vertex_to_global.push_back(v.global);
+    }
+    tile.face_to_global.reserve(faces.size());
+    for(const auto& f : faces)
+    {
+        tile.face_to_global.push_back(f.face);
+    }
+    tile.links =
+        read_range<tile_link>(m_directory / LINKS_FILE, m_link_offsets[t], m_link_offsets[t + 1] - m_link_offsets[t]);
+    return tile;
+}
+
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Triangulation.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace half_edge {
+
+struct tiling_options
+{
+    /// memory allowed for one resident tile and for the sort buffers, in bytes
+    std::size_t memory_budget{std::size_t{256} << 20U};
+    /// number of grid cells along each axis of the bounding box, 0 to derive it from the memory budget; the cells
+    /// over the budget are split further
+    std::size_t tiles_per_side{0};
+};
+
+/// An interior halfedge on the border of a tile whose twin lies in another tile
+struct tile_link
+{
+    index tile{};
+    /// local interior halfedge in the tile, its local twin is an exterior halfedge
+    index half_edge{};
+    index remote_tile{};
+    /// local interior halfedge of the remote tile going the opposite way
+    index remote_half_edge{};
+};
+
+/// A tile loaded in memory, a compact triangulation of the faces whose first vertex lies in the tile cell
+struct mesh_tile
+{
+    index id{};
+    Triangulation mesh;
+    /// local to global index maps, global vertices in increasing order and global faces in file order
+    std::vector<index> vertex_to_global{};
+    std::vector<index> face_to_global{};
+    /// the halfedges of the tile glued to another tile, sorted by halfedge
+    std::vector<tile_link> links{};
+};
+
+/**
+ * Out-of-core mesh split in spatial tiles stored on disk.
+ * The OFF file is streamed once: the vertices and the faces are spilled to disk. The tiles are the cells of a grid
+ * over the bounding box, a cell whose faces do not fit in the memory budget being split in quadrants recursively;
+ * the face counts and the tiles of the vertices come from the faces sorted by first vertex joined with the points,
+ * and the faces are bucketed in the tiles by an external sort. The points of the tiles are gathered the same way, by
+ * joining the vertices of the faces sorted by vertex with the points. Every tile is then built once to record its
+ * border in an external-sorted table of cross-tile edges.
+ * Only one tile is resident at a time, with no array per vertex.
+ */
+class tiled_mesh
+{
+  public:
+    /**
+     * Tiles an OFF file.
+     * @param[in] OFF_file The mesh to tile
+     * @param[in] directory The working directory holding the tile files, created if needed and owned by the caller
+     * @param[in] options The memory budget and tile grid
+     */
+    tiled_mesh(const std::string& OFF_file, std::filesystem::path directory, const tiling_options& options = {});
+
+    [[nodiscard]] auto tile_count() const { return m_face_offsets.size() - 1; }
+    [[nodiscard]] auto tiles_per_side() const { return m_tiles_per_side; }
+    [[nodiscard]] auto vertices_size() const { return n_vertices; }
+    [[nodiscard]] auto faces_size() const { return n_faces; }
+    [[nodiscard]] auto tile_faces(index t) const { return m_face_offsets.at(t + 1) - m_face_offsets.at(t); }
+    [[nodiscard]] auto cross_tile_edges() const { return m_link_offsets.back() / 2; }
+
+    /**
+     * Reads and builds one tile, its halfedges are numbered as during the tiling.
+     * @param[in] t The tile
+     * @return the tile with its index maps and cross-tile links
+     */
+    [[nodiscard]] mesh_tile load_tile(index t) const;
+
+    /**
+     * Calls f on every non-empty tile in turn, a tile is released before the next one is loaded.
+     * @param[in] f The callable taking a const mesh_tile&
+     */
+    template<class F>
+    void for_each_tile(F&& f) const
+    {
+        for(index t = 0; t < tile_count(); ++t)
+        {
+            if(tile_faces(t) > 0)
+            {
+                f(static_cast<const mesh_tile&>(load_tile(t)));
+            }
+        }
+    }
+
+  private:
+    std::filesystem::path m_directory;
+    std::size_t n_vertices{0};
+    std::size_t n_faces{0};
+    std::size_t m_tiles_per_side{1};
+    /// records of tile t in the faces, tile vertices and links files are [offsets[t], offsets[t + 1])
+    std::vector<std::size_t> m_face_offsets{};
+    std::vector<std::size_t> m_vertex_offsets{};
+    std::vector<std::size_t> m_link_offsets{};
+};
+
+}
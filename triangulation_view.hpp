@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Triangulation.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+namespace half_edge {
+
+/// Read-only surface of a triangulation taken by the algorithms that do not edit it: Triangulation itself, a
+/// triangulation_view, a versioned snapshot or a basic_triangulation over any connectivity backend
+template<class M>
+concept triangulation_like = requires(const M& m, index i) {
+    { m.faces_size() } -> std::convertible_to<std::size_t>;
+    { m.halfEdges_size() } -> std::convertible_to<std::size_t>;
+    { m.vertices_size() } -> std::convertible_to<std::size_t>;
+    { m.face_slots() } -> std::convertible_to<std::size_t>;
+    { m.halfEdge_slots() } -> std::convertible_to<std::size_t>;
+    { m.vertex_slots() } -> std::convertible_to<std::size_t>;
+    { m.is_vertex_alive(i) } -> std::convertible_to<bool>;
+    { m.is_halfEdge_alive(i) } -> std::convertible_to<bool>;
+    { m.is_face_alive(i) } -> std::convertible_to<bool>;
+    { m.origin(i) } -> std::convertible_to<index>;
+    { m.target(i) } -> std::convertible_to<index>;
+    { m.twin(i) } -> std::convertible_to<index>;
+    { m.next(i) } -> std::convertible_to<index>;
+    { m.prev(i) } -> std::convertible_to<index>;
+    { m.edge_of_vertex(i) } -> std::convertible_to<index>;
+    { m.CCW_edge_to_vertex(i) } -> std::convertible_to<index>;
+    { m.CW_edge_to_vertex(i) } -> std::convertible_to<index>;
+    { m.is_border_face(i) } -> std::convertible_to<bool>;
+    { m.is_border_vertex(i) } -> std::convertible_to<bool>;
+    { m.get_PointX(i) } -> std::convertible_to<double>;
+    { m.get_PointY(i) } -> std::convertible_to<double>;
+};
+
+/**
+ * The const accessors of Triangulation, written once for every read-only storage. The derived class D provides the
+ * element counts faces_size(), halfEdges_size() and vertices_size(), the slot counts halfEdge_slots() and
+ * vertex_slots(), and the records vertex_at(v) and half_edge_at(e), by reference or by value.
+ */
+template<class D>
+class triangulation_accessors
+{
+  public:
+    [[nodiscard]] auto face_slots() const { return self().halfEdge_slots() / 3; }
+
+    [[nodiscard]] bool is_vertex_alive(index v) const
+    {
+        return v < self().vertex_slots() && !self().vertex_at(v).is_removed;
+    }
+    [[nodiscard]] bool is_halfEdge_alive(index e) const
+    {
+        return e < self().halfEdge_slots() && !self().half_edge_at(e).is_removed;
+    }
+    [[nodiscard]] bool is_face_alive(index f) const
+    {
+        return 3 * f < self().halfEdge_slots() && !self().half_edge_at(3 * f).is_removed &&
+               !self().half_edge_at(3 * f).is_border;
+    }
+
+    // the accessors do not check the indices
+    [[nodiscard]] index origin(index e) const { return self().half_edge_at(e).origin; }
+    [[nodiscard]] index target(index e) const { return origin(twin(e)); }
+    [[nodiscard]] index twin(index e) const { return self().half_edge_at(e).twin; }
+    [[nodiscard]] index next(index e) const { return self().half_edge_at(e).next; }
+    [[nodiscard]] index prev(index e) const { return self().half_edge_at(e).prev; }
+    [[nodiscard]] index edge_of_vertex(index v) const { return self().vertex_at(v).incident_halfedge; }
+    [[nodiscard]] index CCW_edge_to_vertex(index e) const { return twin(prev(e)); }
+    [[nodiscard]] index CW_edge_to_vertex(index e) const { return next(twin(e)); }
+    [[nodiscard]] bool is_border_face(index e) const { return self().half_edge_at(e).is_border; }
+    [[nodiscard]] bool is_border_vertex(index v) const { return self().vertex_at(v).is_border; }
+    [[nodiscard]] double get_PointX(index v) const { return self().vertex_at(v).x; }
+    [[nodiscard]] double get_PointY(index v) const { return self().vertex_at(v).y; }
+
+  private:
+    [[nodiscard]] const D& self() const { return static_cast<const D&>(*this); }
+};
+
+/// Read-only triangulation over storage it does not own, with the const accessors of Triangulation
+class triangulation_view : public triangulation_accessors<triangulation_view>
+{
+  public:
+    triangulation_view() = default;
+
+    triangulation_view(std::span<const vertex> vertices,
+                       std::span<const half_edge> half_edges,
+                       std::size_t vertices_count,
+                       std::size_t half_edges_count,
+                       std::size_t faces_count)
+        : m_vertices(vertices), m_half_edges(half_edges), n_vertices(vertices_count), n_half_edges(half_edges_count),
+          n_faces(faces_count)
+    {
+    }
+
+    // View of a triangulation, valid until its next edit
+    explicit triangulation_view(const Triangulation& tri)
+        : triangulation_view(
+              tri.vertex_storage(), tri.halfEdge_storage(), tri.vertices_size(), tri.halfEdges_size(), tri.faces_size())
+    {
+    }
+
+    [[nodiscard]] auto faces_size() const { return n_faces; }
+    [[nodiscard]] auto halfEdges_size() const { return n_half_edges; }
+    [[nodiscard]] auto vertices_size() const { return n_vertices; }
+    [[nodiscard]] auto halfEdge_slots() const { return m_half_edges.size(); }
+    [[nodiscard]] auto vertex_slots() const { return m_vertices.size(); }
+
+  private:
+    friend class triangulation_accessors<triangulation_view>;
+
+    [[nodiscard]] const vertex& vertex_at(index v) const { return m_vertices[v]; }
+    [[nodiscard]] const half_edge& half_edge_at(index e) const { return m_half_edges[e]; }
+
+    std::span<const vertex> m_vertices{};
+    std::span<const half_edge> m_half_edges{};
+    std::size_t n_vertices{0};
+    std::size_t n_half_edges{0};
+    std::size_t n_faces{0};
+};
+
+}
@@ -0,0 +1,144 @@
+#include "versioned.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <thread>
+
+namespace half_edge {
+
+namespace {
+
+// chunks of the new storage, sharing the chunks of the previous version the writer did not change
+template<class T, class Changed>
+std::vector<std::shared_ptr<const versioned_triangulation::chunk<T>>> share_chunks(
+    std::span<const T> items,
+    const std::vector<std::shared_ptr<const versioned_triangulation::chunk<T>>>& previous,
+    std::size_t previous_size,
+    Changed&& changed)
+{
+    constexpr auto chunk_size = versioned_triangulation::CHUNK_SIZE;
+    const auto n_chunks = (items.size() + chunk_size - 1) / chunk_size;
+    std::vector<std::shared_ptr<const versioned_triangulation::chunk<T>>> chunks(n_chunks);
+    for(std::size_t c = 0; c < n_chunks; ++c)
+    {
+        const auto begin = c * chunk_size;
+        const auto count = std::min(chunk_size, items.size() - begin);
+        if(c < previous.size() && count == std::min(chunk_size, previous_size - begin) && !changed(c))
+        {
+            chunks[c] = previous[c];
+            continue;
+        }
+        auto fresh = std::make_shared<versioned_triangulation::chunk<T>>();
+        std::copy_n(items.begin() + static_cast<std::ptrdiff_t>(begin), count, fresh->begin());
+        chunks[c] = std::move(fresh);
+    }
+    return chunks;
+}
+}
+
+versioned_triangulation::versioned_triangulation(Triangulation tri, std::size_t max_readers)
+    : m_working(std::move(tri)), m_slots(std::make_unique<reader_slot[]>(std::max<std::size_t>(1, max_readers))),
+      m_slot_count(std::max<std::size_t>(1, max_readers))
+{
+    m_working.track_changes(true);
+    const auto all = [](std::size_t) { return true; };
+    auto initial = std::make_unique<version>();
+    initial->vertices = share_chunks<vertex>(m_working.vertex_storage(), {}, 0, all);
+    initial->half_edges = share_chunks<half_edge>(m_working.halfEdge_storage(), {}, 0, all);
+    initial->vertex_slots = m_working.vertex_slots();
+    initial->half_edge_slots = m_working.halfEdge_slots();
+    initial->n_vertices = m_working.vertices_size();
+    initial->n_half_edges = m_working.halfEdges_size();
+    initial->n_faces = m_working.faces_size();
+    m_current.store(initial.release(), std::memory_order_release);
+}
+
+versioned_triangulation::~versioned_triangulation() { delete m_current.load(std::memory_order_acquire); }
+
+versioned_triangulation::snapshot versioned_triangulation::read() const
+{
+    // start the search at a slot depending on the thread to spread the readers
+    const auto start = std::hash<std::thread::id>{}(std::this_thread::get_id()) % m_slot_count;
+    while(true)
+    {
+        for(std::size_t k = 0; k < m_slot_count; ++k)
+        {
+            auto& slot = m_slots[(start + k) % m_slot_count];
+            auto expected = IDLE;
+            // the announcement is ordered before the load of the version, a writer retiring the version afterwards
+            // sees the slot busy with an older epoch
+            if(slot.epoch.load(std::memory_order_relaxed) == IDLE &&
+               slot.epoch.compare_exchange_strong(expected, m_epoch.load(std::memory_order_seq_cst)))
+            {
+                return {&slot, m_current.load(std::memory_order_seq_cst)};
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+std::uint64_t versioned_triangulation::publish_locked()
+{
+    const auto* current = m_current.load(std::memory_order_relaxed);
+    auto next = std::make_unique<version>();
+    next->number = current->number + 1;
+    // an edit assigning another triangulation to the working copy also replaces its change record
+    const auto tracked = m_working.is_tracking_changes();
+    next->vertices = share_chunks<vertex>(m_working.vertex_storage(),
+                                          current->vertices,
+                                          current->vertex_slots,
+                                          [&](std::size_t c)
+                                          { return !tracked || m_working.is_vertex_block_changed(c); });
+    next->half_edges = share_chunks<half_edge>(m_working.halfEdge_storage(),
+                                               current->half_edges,
+                                               current->half_edge_slots,
+                                               [&](std::size_t c)
+                                               { return !tracked || m_working.is_halfEdge_block_changed(c); });
+    m_working.track_changes(true);
+    next->vertex_slots = m_working.vertex_slots();
+    next->half_edge_slots = m_working.halfEdge_slots();
+    next->n_vertices = m_working.vertices_size();
+    next->n_half_edges = m_working.halfEdges_size();
+    next->n_faces = m_working.faces_size();
+    const auto number = next->number;
+
+    m_current.store(next.release(), std::memory_order_seq_cst);
+    // readers announcing this epoch or a later one load the new version
+    const auto retire_epoch = m_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+    m_retired.emplace_back(retire_epoch, current);
+    reclaim_locked();
+    return number;
+}
+
+std::size_t versioned_triangulation::reclaim()
+{
+    const std::scoped_lock lock(m_writer_mutex);
+    return reclaim_locked();
+}
+
+std::size_t versioned_triangulation::reclaim_locked()
+{
+    auto oldest = IDLE;
+    for(std::size_t k = 0; k < m_slot_count; ++k)
+    {
+        oldest = std::min(oldest, m_slots[k].epoch.load(std::memory_order_seq_cst));
+    }
+    const auto freed = std::erase_if(m_retired, [oldest](const auto& retired) { return retired.first <= oldest; });
+    return static_cast<std::size_t>(freed);
+}
+
+std::size_t versioned_triangulation::retired_versions() const
+{
+    const std::scoped_lock lock(m_writer_mutex);
+    return m_retired.size();
+}
+
+std::uint64_t versioned_triangulation::version_number() const
+{
+    // the version can only be dereferenced under a reader slot
+    return read().version_number();
+}
+
+}
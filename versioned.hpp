@@ -0,0 +1,170 @@
+#pragma once
+
+#include "Triangulation.hpp"
+#include "triangulation_view.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace half_edge {
+
+/**
+ * Triangulation shared between lock-free readers and a writer through immutable versions.
+ * The vertex and halfedge arrays of a version are split in chunks of CHUNK_SIZE elements held by shared pointers;
+ * publishing a version copies only the chunks the writer modified, as recorded by the change tracking of the working
+ * copy, and shares the others with the previous version.
+ * Readers announce the epoch they read in, and a retired version is freed once every reader moved past it
+ * (epoch-based reclamation), which releases the chunks no other version uses.
+ */
+class versioned_triangulation
+{
+  public:
+    static constexpr std::size_t CHUNK_SHIFT = Triangulation::CHANGE_BLOCK_SHIFT;
+    static constexpr std::size_t CHUNK_SIZE = std::size_t{1} << CHUNK_SHIFT;
+    static constexpr std::size_t CHUNK_MASK = CHUNK_SIZE - 1;
+
+    template<class T>
+    using chunk = std::array<T, CHUNK_SIZE>;
+
+    /// Immutable state of the triangulation after a given number of updates
+    struct version
+    {
+        std::uint64_t number{0};
+        std::vector<std::shared_ptr<const chunk<vertex>>> vertices{};
+        std::vector<std::shared_ptr<const chunk<half_edge>>> half_edges{};
+        std::size_t vertex_slots{0};
+        std::size_t half_edge_slots{0};
+        std::size_t n_vertices{0};
+        std::size_t n_half_edges{0};
+        std::size_t n_faces{0};
+    };
+
+  private:
+    static constexpr auto IDLE = ~std::uint64_t{0};
+
+    struct alignas(64) reader_slot
+    {
+        /// epoch announced by the reader holding the slot, IDLE if the slot is free
+        std::atomic<std::uint64_t> epoch{IDLE};
+    };
+
+  public:
+    /// Consistent read-only view of one version, it holds a reader slot until destroyed
+    class snapshot : public triangulation_accessors<snapshot>
+    {
+      public:
+        snapshot(const snapshot&) = delete;
+        snapshot& operator=(const snapshot&) = delete;
+        snapshot(snapshot&& other) noexcept
+            : m_slot(std::exchange(other.m_slot, nullptr)), m_version(std::exchange(other.m_version, nullptr))
+        {
+        }
+        snapshot& operator=(snapshot&& other) noexcept
+        {
+            if(this != &other)
+            {
+                release();
+                m_slot = std::exchange(other.m_slot, nullptr);
+                m_version = std::exchange(other.m_version, nullptr);
+            }
+            return *this;
+        }
+        ~snapshot() { release(); }
+
+        [[nodiscard]] const version& data() const { return *m_version; }
+        [[nodiscard]] auto version_number() const { return m_version->number; }
+
+        [[nodiscard]] auto faces_size() const { return m_version->n_faces; }
+        [[nodiscard]] auto halfEdges_size() const { return m_version->n_half_edges; }
+        [[nodiscard]] auto vertices_size() const { return m_version->n_vertices; }
+        [[nodiscard]] auto halfEdge_slots() const { return m_version->half_edge_slots; }
+        [[nodiscard]] auto vertex_slots() const { return m_version->vertex_slots; }
+
+      private:
+        friend class versioned_triangulation;
+        friend class triangulation_accessors<snapshot>;
+        snapshot(reader_slot* slot, const version* v) : m_slot(slot), m_version(v) {}
+
+        [[nodiscard]] const vertex& vertex_at(index v) const
+        {
+            return (*m_version->vertices[v >> CHUNK_SHIFT])[v & CHUNK_MASK];
+        }
+        [[nodiscard]] const half_edge& half_edge_at(index e) const
+        {
+            return (*m_version->half_edges[e >> CHUNK_SHIFT])[e & CHUNK_MASK];
+        }
+        void release() noexcept
+        {
+            if(m_slot != nullptr)
+            {
+                m_slot->epoch.store(IDLE, std::memory_order_release);
+                m_slot = nullptr;
+            }
+        }
+
+        reader_slot* m_slot{nullptr};
+        const version* m_version{nullptr};
+    };
+
+    /**
+     * Publishes the triangulation as version 0.
+     * @param[in] tri The triangulation, kept as the working copy of the writer
+     * @param[in] max_readers The number of snapshots that can be held at the same time, more readers wait
+     */
+    explicit versioned_triangulation(Triangulation tri, std::size_t max_readers = 64);
+    versioned_triangulation(const versioned_triangulation&) = delete;
+    versioned_triangulation& operator=(const versioned_triangulation&) = delete;
+    // all the snapshots must have been released
+    ~versioned_triangulation();
+
+    /**
+     * Takes a snapshot of the latest version without locking.
+     * @return the snapshot, which keeps its version alive
+     */
+    [[nodiscard]] snapshot read() const;
+
+    /**
+     * Applies the edit to the working copy of the writer and publishes the result atomically, the writers are
+     * serialized. If the edit throws nothing is published and the working copy is left as the edit left it.
+     * @param[in] edit The callable taking a Triangulation&
+     * @return the number of the published version
+     */
+    template<class F>
+    std::uint64_t update(F&& edit)
+    {
+        const std::scoped_lock lock(m_writer_mutex);
+        std::forward<F>(edit)(m_working);
+        return publish_locked();
+    }
+
+    /**
+     * Frees the retired versions no reader can see any more, this is also done after each update.
+     * @return the number of versions freed
+     */
+    std::size_t reclaim();
+
+    [[nodiscard]] std::size_t retired_versions() const;
+    [[nodiscard]] std::uint64_t version_number() const;
+
+  private:
+    std::uint64_t publish_locked();
+    std::size_t reclaim_locked();
+
+    /// writer copy of the triangulation, the base of the next version
+    Triangulation m_working;
+    mutable std::mutex m_writer_mutex;
+    std::atomic<const version*> m_current{nullptr};
+    std::atomic<std::uint64_t> m_epoch{1};
+    std::unique_ptr<reader_slot[]> m_slots;
+    std::size_t m_slot_count;
+    /// versions replaced by a newer one with the epoch at which they were retired
+    std::vector<std::pair<std::uint64_t, std::unique_ptr<const version>>> m_retired{};
+};
+
+}
@@ -0,0 +1,299 @@
+#include "welding.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+
+namespace half_edge {
+
+namespace {
+
+constexpr std::size_t DIGIT_BITS = 16;
+constexpr std::size_t BUCKETS = std::size_t{1} << DIGIT_BITS;
+/// below this size a comparison sort is faster than the radix passes
+constexpr std::size_t RADIX_THRESHOLD = BUCKETS;
+/// largest number of cells along an axis, the cell coordinates fit in 31 bits
+constexpr double MAX_CELLS = 2147483647.;
+
+struct keyed_vertex
+{
+    /// cell row in the high 32 bits, cell column in the low ones
+    std::uint64_t key;
+    index v;
+};
+
+constexpr std::uint64_t make_key(std::uint64_t cx, std::uint64_t cy) { return (cy << 32U) | cx; }
+
+// stable least significant digit radix sort on the keys, the passes over a constant digit are skipped
+void radix_sort(std::pmr::vector<keyed_vertex>& items, std::size_t threads)
+{
+    const auto n = items.size();
+    if(n < RADIX_THRESHOLD)
+    {
+        std::ranges::sort(items, {}, [](const keyed_vertex& k) { return std::pair{k.key, k.v}; });
+        return;
+    }
+    const auto n_threads = resolve_threads(threads, n / RADIX_THRESHOLD);
+    const auto chunk = (n + n_threads - 1) / n_threads;
+    std::pmr::vector<keyed_vertex> buffer(n, items.get_allocator());
+    std::pmr::vector<std::size_t> counts(n_threads * BUCKETS, items.get_allocator());
+    for(std::size_t shift = 0; shift < 64; shift += DIGIT_BITS)
+    {
+        auto digit = [shift](const keyed_vertex& k)
+        { return static_cast<std::size_t>(k.key >> shift) & (BUCKETS - 1); };
+        std::ranges::fill(counts, 0);
+        parallel_for(n_threads,
+                     n_threads,
+                     [&](std::size_t t_begin, std::size_t t_end)
+                     {
+                         for(auto t = t_begin; t < t_end; ++t)
+                         {
+                             auto* count = counts.data() + t * BUCKETS;
+                             for(auto k = t * chunk; k < std::min(n, (t + 1) * chunk); ++k)
+                             {
+                                 ++count[digit(items[k])];
+                             }
+                         }
+                     });
+        // exclusive offsets, bucket major so that the chunks keep their order within a bucket
+        std::size_t offset = 0;
+        bool constant = false;
+        for(std::size_t d = 0; d < BUCKETS; ++d)
+        {
+            std::size_t bucket = 0;
+            for(std::size_t t = 0; t < n_threads; ++t)
+            {
+                const auto c = counts[t * BUCKETS + d];
+                counts[t * BUCKETS + d] = offset;
+                offset += c;
+                bucket += c;
+            }
+            constant = constant || bucket == n;
+        }
+        if(constant)
+        {
+            continue;
+        }
+        parallel_for(n_threads,
+                     n_threads,
+                     [&](std::size_t t_begin, std::size_t t_end)
+                     {
+                         for(auto t = t_begin; t < t_end; ++t)
+                         {
+                             auto* next = counts.data() + t * BUCKETS;
+                             for(auto k = t * chunk; k < std::min(n, (t + 1) * chunk); ++k)
+                             {
+                                 buffer[next[digit(items[k])]++] = items[k];
+                             }
+                         }
+                     });
+        items.swap(buffer);
+    }
+}
+
+index find_root(std::pmr::vector<index>& parent, index v)
+{
+    while(parent[v] != v)
+    {
+        parent[v] = parent[parent[v]];
+        v = parent[v];
+    }
+    return v;
+}
+
+// the smallest index becomes the root so that a cluster keeps its first vertex
+void unite(std::pmr::vector<index>& parent, index a, index b)
+{
+    a = find_root(parent, a);
+    b = find_root(parent, b);
+    if(a != b)
+    {
+        parent[std::max(a, b)] = std::min(a, b);
+    }
+}
+
+// welds in place, the survivors are moved to the front of the spans
+welding_result weld_in_place(std::span<vertex> vertices, std::span<index> faces, const welding_options& options)
+{
+    auto* resource = options.scratch != nullptr ? options.scratch : std::pmr::get_default_resource();
+    const auto n = vertices.size();
+    welding_result result{.vertex_map = std::pmr::vector<index>(n, resource)};
+    std::iota(result.vertex_map.begin(), result.vertex_map.end(), index{0});
+    if(n == 0)
+    {
+        return result;
+    }
+
+    auto min_x = std::numeric_limits<double>::max();
+    auto min_y = std::numeric_limits<double>::max();
+    auto max_x = std::numeric_limits<double>::lowest();
+    auto max_y = std::numeric_limits<double>::lowest();
+    for(const auto& v : vertices)
+    {
+        min_x = std::min(min_x, v.x);
+        min_y = std::min(min_y, v.y);
+        max_x = std::max(max_x, v.x);
+        max_y = std::max(max_y, v.y);
+    }
+    const auto extent = std::max(max_x - min_x, max_y - min_y);
+    const auto epsilon = options.epsilon > 0 ? options.epsilon : RELATIVE_WELDING_EPSILON * extent;
+    // coarser cells when the grid would not fit the keys, the vertices of a cell are then compared one by one
+    const auto cell = std::max(epsilon, extent / MAX_CELLS);
+    const bool coarse = cell > epsilon;
+    // a zero cell means that all the vertices are at the same place
+    const auto inv_cell = cell > 0 ? 1 / cell : 0.;
+
+    std::pmr::vector<keyed_vertex> keys(n, resource);
+    parallel_for(n,
+                 options.threads,
+                 [&](std::size_t begin, std::size_t end)
+                 {
+                     for(auto k = begin; k < end; ++k)
+                     {
+                         const auto cx = static_cast<std::uint64_t>((vertices[k].x - min_x) * inv_cell);
+                         const auto cy = static_cast<std::uint64_t>((vertices[k].y - min_y) * inv_cell);
+                         keys[k] = {make_key(cx, cy), k};
+                     }
+                 });
+    radix_sort(keys, options.threads);
+
+    std::pmr::vector<index> parent(n, resource);
+    std::iota(parent.begin(), parent.end(), index{0});
+    auto close = [&vertices, epsilon](index a, index b)
+    {
+        return std::abs(vertices[a].x - vertices[b].x) <= epsilon && std::abs(vertices[a].y - vertices[b].y) <= epsilon;
+    };
+    // merge each cell with the cells right of it and above it, the cursor into the row above only moves forward
+    std::size_t above = 0;
+    for(std::size_t begin = 0; begin < n;)
+    {
+        const auto key = keys[begin].key;
+        auto end = begin + 1;
+        while(end < n && keys[end].key == key)
+        {
+            if(!coarse)
+            {
+                unite(parent, keys[begin].v, keys[end].v);
+            }
+            else
+            {
+                for(auto j = begin; j < end; ++j)
+                {
+                    if(close(keys[j].v, keys[end].v))
+                    {
+                        unite(parent, keys[j].v, keys[end].v);
+                    }
+                }
+            }
+            ++end;
+        }
+        const auto cx = key & 0xFFFFFFFFU;
+        const auto cy = key >> 32U;
+        auto merge_cell = [&](std::size_t from, std::uint64_t neighbour)
+        {
+            for(auto k = from; k < n && keys[k].key == neighbour; ++k)
+            {
+                for(auto j = begin; j < end; ++j)
+                {
+                    if(close(keys[j].v, keys[k].v))
+                    {
+                        unite(parent, keys[j].v, keys[k].v);
+                    }
+                }
+            }
+        };
+        if(end < n && keys[end].key == key + 1)
+        {
+            merge_cell(end, key + 1);
+        }
+        const auto first_above = make_key(cx > 0 ? cx - 1 : cx, cy + 1);
+        above = std::max(above, end);
+        while(above < n && keys[above].key < first_above)
+        {
+            ++above;
+        }
+        for(auto k = above; k < n && keys[k].key <= make_key(cx + 1, cy + 1); ++k)
+        {
+            if(k == above || keys[k].key != keys[k - 1].key)
+            {
+                merge_cell(k, keys[k].key);
+            }
+        }
+        begin = end;
+    }
+
+    // survivors keep their order, the vertex map points every vertex to the new index of its root
+    index n_kept = 0;
+    for(index v = 0; v < n; ++v)
+    {
+        const auto root = find_root(parent, v);
+        if(root == v)
+        {
+            result.vertex_map[v] = n_kept;
+            vertices[n_kept++] = vertices[v];
+        }
+        else
+        {
+            result.vertex_map[v] = result.vertex_map[root];
+        }
+    }
+    result.merged_vertices = n - n_kept;
+
+    parallel_for(faces.size(),
+                 options.threads,
+                 [&faces, &result, n](std::size_t begin, std::size_t end)
+                 {
+                     // an index out of range stays out of range, the construction reports it
+                     for(auto k = begin; k < end; ++k)
+                     {
+                         if(faces[k] < n)
+                         {
+                             faces[k] = result.vertex_map[faces[k]];
+                         }
+                     }
+                 });
+    std::size_t kept_faces = 0;
+    for(std::size_t f = 0; f < faces.size(); f += 3)
+    {
+        const auto a = faces[f];
+        const auto b = faces[f + 1];
+        const auto c = faces[f + 2];
+        if(a == b || b == c || c == a)
+        {
+            continue;
+        }
+        faces[kept_faces++] = a;
+        faces[kept_faces++] = b;
+        faces[kept_faces++] = c;
+    }
+    result.dropped_faces = (faces.size() - kept_faces) / 3;
+    return result;
+}
+
+}
+
+template<class VertexAllocator, class IndexAllocator>
+welding_result weld_vertices(std::vector<vertex, VertexAllocator>& vertices,
+                             std::vector<index, IndexAllocator>& faces,
+                             const welding_options& options)
+{
+    if(faces.size() % 3 != 0)
+    {
+        throw std::invalid_argument("the number of face indices must be a multiple of 3");
+    }
+    auto result = weld_in_place(vertices, faces, options);
+    vertices.resize(vertices.size() - result.merged_vertices);
+    faces.resize(faces.size() - 3 * result.dropped_faces);
+    return result;
+}
+
+template welding_result weld_vertices(std::vector<vertex>&, std::vector<index>&, const welding_options&);
+template welding_result weld_vertices(std::pmr::vector<vertex>&, std::pmr::vector<index>&, const welding_options&);
+
+}
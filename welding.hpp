@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Triangulation.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace half_edge {
+
+struct welding_options
+{
+    /// whether Triangulation(const std::string&, const welding_options&) welds the vertices
+    bool enabled{true};
+    /// vertices whose coordinates differ by at most epsilon on both axes are merged, transitively; 0 uses
+    /// RELATIVE_WELDING_EPSILON times the extent of the bounding box
+    double epsilon{0.};
+    /// number of worker threads, 0 for the hardware concurrency
+    std::size_t threads{0};
+    /// resource of the sort buffers and of the vertex map, nullptr for the default resource
+    std::pmr::memory_resource* scratch{nullptr};
+};
+
+/// default welding distance relative to the extent of the mesh, merges the duplicates left by exporters
+constexpr double RELATIVE_WELDING_EPSILON = 1e-9;
+
+struct welding_result
+{
+    /// new index of every input vertex
+    std::pmr::vector<index> vertex_map{};
+    std::size_t merged_vertices{0};
+    std::size_t dropped_faces{0};
+};
+
+/**
+ * Merges the vertices closer than epsilon, in place between parsing and construction. The vertices are sorted on
+ * their quantized coordinates by a parallel radix sort, then each grid cell is merged with its neighbouring cells.
+ * A cluster keeps the coordinates of its first vertex and the survivors keep their relative order. The face indices
+ * are remapped in place and the faces left with a repeated vertex are dropped. Instantiated for the standard and the
+ * polymorphic allocators.
+ * @param[in,out] vertices The vertices
+ * @param[in,out] faces The flatten vector of triangle vertex indices
+ * @param[in] options The welding distance, number of threads and scratch resource
+ * @return the vertex remapping and what was removed
+ */
+template<class VertexAllocator, class IndexAllocator>
+welding_result weld_vertices(std::vector<vertex, VertexAllocator>& vertices,
+                             std::vector<index, IndexAllocator>& faces,
+                             const welding_options& options = {});
+
+}